@@ -0,0 +1,105 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2026 Ed Lee
+//
+// Introspection XML parsing: the streaming IntrospectionXml scanner against
+// the std::regex extraction it replaced, on a synthetic document shaped like
+// the systemd manager object (large interface, many child nodes).
+//
+//   cmake -DBUILD_BENCHMARKS=ON .. && make bench-introspection
+//   ./bench-introspection [iterations]
+
+#include "IntrospectionXml.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <regex>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::string makeDocument() {
+    std::string xml =
+        "<!DOCTYPE node PUBLIC \"-//freedesktop//DTD D-BUS Object Introspection 1.0//EN\"\n"
+        " \"http://www.freedesktop.org/standards/dbus/1.0/introspect.dtd\">\n<node>\n"
+        " <interface name=\"org.freedesktop.DBus.Peer\">\n"
+        "  <method name=\"Ping\"/>\n"
+        "  <method name=\"GetMachineId\"><arg type=\"s\" name=\"machine_uuid\" direction=\"out\"/></method>\n"
+        " </interface>\n";
+    xml += " <interface name=\"org.freedesktop.systemd1.Manager\">\n";
+    for (int i = 0; i < 200; ++i) {
+        auto n = std::to_string(i);
+        xml += "  <property name=\"Property" + n + "\" type=\"t\" access=\"read\">\n"
+               "   <annotation name=\"org.freedesktop.DBus.Property.EmitsChangedSignal\" value=\"const\"/>\n"
+               "  </property>\n";
+        xml += "  <method name=\"Method" + n + "\">\n"
+               "   <arg type=\"s\" name=\"name\" direction=\"in\"/>\n"
+               "   <arg type=\"s\" name=\"mode\" direction=\"in\"/>\n"
+               "   <arg type=\"o\" name=\"job\" direction=\"out\"/>\n"
+               "  </method>\n";
+        if (i % 10 == 0) {
+            xml += "  <signal name=\"Signal" + n + "\">\n"
+                   "   <arg type=\"u\" name=\"id\"/>\n"
+                   "   <arg type=\"o\" name=\"job\"/>\n"
+                   "  </signal>\n";
+        }
+    }
+    xml += " </interface>\n";
+    for (int i = 0; i < 300; ++i) {
+        xml += " <node name=\"unit" + std::to_string(i) + "\"/>\n";
+    }
+    xml += "</node>\n";
+    return xml;
+}
+
+// ── the previous implementation ───────────────────────────────────────────────
+
+std::vector<std::string> regexExtract(const std::string& xml, const std::string& element,
+                                      const std::string& attr) {
+    std::vector<std::string> results;
+    std::regex re("<" + element + "\\s+" + attr + "=\"([^\"]+)\"");
+    for (auto it = std::sregex_iterator(xml.begin(), xml.end(), re); it != std::sregex_iterator(); ++it) {
+        results.push_back((*it)[1]);
+    }
+    std::sort(results.begin(), results.end());
+    results.erase(std::unique(results.begin(), results.end()), results.end());
+    return results;
+}
+
+size_t regexParse(const std::string& xml) {
+    return regexExtract(xml, "interface", "name").size() + regexExtract(xml, "signal", "name").size() +
+           regexExtract(xml, "method", "name").size() + regexExtract(xml, "node", "name").size();
+}
+
+size_t streamingParse(const std::string& xml) {
+    DbusObject obj = IntrospectionXml::parse(xml);
+    size_t n = obj.interfaces.size() + obj.children.size();
+    for (const auto& iface : obj.interfaces) n += iface.methods.size() + iface.signals.size();
+    return n;
+}
+
+template <typename F>
+double perIterationUs(F parse, const std::string& xml, int iterations, size_t& result) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) result = parse(xml);
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / iterations;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int iterations = argc > 1 ? std::atoi(argv[1]) : 50;
+    std::string xml = makeDocument();
+
+    size_t regexCount = 0, streamCount = 0;
+    double regexUs  = perIterationUs(regexParse, xml, iterations, regexCount);
+    double streamUs = perIterationUs(streamingParse, xml, iterations, streamCount);
+
+    std::cout << "document: " << xml.size() << " bytes, " << iterations << " iterations\n"
+              << "regex:     " << regexUs  << " us/parse (" << regexCount  << " names)\n"
+              << "streaming: " << streamUs << " us/parse (" << streamCount << " names, full model)\n"
+              << "speedup:   " << regexUs / streamUs << "x" << std::endl;
+    return 0;
+}
@@ -0,0 +1,98 @@
+#!/bin/bash
+# SPDX-License-Identifier: GPL-3.0-or-later
+# Copyright (C) 2026 Ed Lee
+
+# Cold-start benchmark: starts the bridge with synthetic configs of 10, 1k
+# and 10k mappings and prints the "Startup:" phase line it logs once it is
+# fully up.  Every size runs twice: cold (empty config cache) and warm
+# (config snapshot present).
+#
+# Needs a built binary, dbus-run-session (mappings use a private session
+# bus) and either mosquitto in PATH or a broker given with BROKER=host:port.
+#
+#   bench/bench-startup.sh [sizes...]      # default: 10 1000 10000
+
+set -e
+
+if [ -f "./build/dbus-mqtt-bridge" ]; then
+    BINARY="$(pwd)/build/dbus-mqtt-bridge"
+elif [ -f "/usr/bin/dbus-mqtt-bridge" ]; then
+    BINARY="/usr/bin/dbus-mqtt-bridge"
+else
+    echo "Error: dbus-mqtt-bridge binary not found"
+    exit 1
+fi
+
+SIZES=("$@")
+[ ${#SIZES[@]} -eq 0 ] && SIZES=(10 1000 10000)
+
+WORK="$(mktemp -d)"
+BROKER_PID=""
+cleanup() {
+    [ -n "$BROKER_PID" ] && kill "$BROKER_PID" 2>/dev/null
+    rm -rf "$WORK"
+}
+trap cleanup EXIT
+
+if [ -z "$BROKER" ]; then
+    PORT=$((20000 + RANDOM % 10000))
+    mosquitto -p "$PORT" >"$WORK/mosquitto.log" 2>&1 &
+    BROKER_PID=$!
+    BROKER="localhost:$PORT"
+    sleep 0.5
+fi
+
+# Half the mappings publish D-Bus signals, half subscribe to MQTT topics.
+make_config() {
+    local n=$1 file=$2 i
+    {
+        echo "mqtt:"
+        echo "  broker: ${BROKER%:*}"
+        echo "  port: ${BROKER##*:}"
+        echo "bus_type: session"
+        echo "mappings:"
+        echo "  dbus_to_mqtt:"
+        for ((i = 0; i < (n + 1) / 2; i++)); do
+            echo "    - service: org.example.Bench$i"
+            echo "      path: /org/example/Object$i"
+            echo "      interface: org.example.Bench"
+            echo "      signal: Changed"
+            echo "      topic: bench/out/$i"
+        done
+        echo "  mqtt_to_dbus:"
+        for ((i = 0; i < n / 2; i++)); do
+            echo "    - topic: bench/in/$i"
+            echo "      service: org.example.Bench$i"
+            echo "      path: /org/example/Object$i"
+            echo "      interface: org.example.Bench"
+            echo "      method: Call"
+        done
+    } >"$file"
+}
+
+# Runs the bridge until it logs its startup summary, then stops it.
+run_once() {
+    local config=$1 log="$WORK/bridge.log"
+    XDG_CACHE_HOME="$WORK/cache" CACHE_DIRECTORY= \
+        dbus-run-session -- "$BINARY" "$config" >"$log" 2>&1 &
+    local pid=$!
+    for ((t = 0; t < 600; t++)); do
+        grep -q "^Startup:" "$log" && break
+        kill -0 "$pid" 2>/dev/null || break
+        sleep 0.1
+    done
+    kill -INT "$pid" 2>/dev/null || true
+    wait "$pid" 2>/dev/null || true
+    grep "^Startup:" "$log" || { echo "no startup summary; log:"; tail -5 "$log"; }
+}
+
+for n in "${SIZES[@]}"; do
+    config="$WORK/config-$n.yaml"
+    make_config "$n" "$config"
+    rm -rf "$WORK/cache"
+    echo "=== $n mappings, cold ==="
+    run_once "$config"
+    echo "=== $n mappings, warm (config snapshot) ==="
+    run_once "$config"
+    echo
+done
@@ -0,0 +1,100 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2026 Ed Lee
+//
+// Config::validate() on a synthetic config with many mappings: the name
+// checks against the std::regex versions they replaced, then the full
+// validation serially and spread over all cores.
+//
+//   cmake -DBUILD_BENCHMARKS=ON .. && make bench-validation
+//   ./bench-validation [mappings]
+
+#include "Config.h"
+#include "ConfigValidator.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <regex>
+#include <string>
+#include <thread>
+
+namespace {
+
+Config makeConfig(size_t mappings) {
+    Config config;
+    config.mqtt.broker = "broker.example.com";
+    for (size_t i = 0; i < mappings; ++i) {
+        auto n = std::to_string(i);
+        DbusToMqttMapping out;
+        out.service   = "org.example.Service" + n;
+        out.path      = "/org/example/Object" + n;
+        out.interface = "org.example.Interface" + n;
+        out.signal    = "Changed" + n;
+        out.topic     = "example/object" + n + "/changed";
+        config.dbus_to_mqtt.push_back(std::move(out));
+
+        MqttToDbusMapping in;
+        in.topic     = "example/object" + n + "/call";
+        in.service   = "org.example.Service" + n;
+        in.path      = "/org/example/Object" + n;
+        in.interface = "org.example.Interface" + n;
+        in.method    = "Call" + n;
+        config.mqtt_to_dbus.push_back(std::move(in));
+    }
+    return config;
+}
+
+// ── the previous implementation ───────────────────────────────────────────────
+
+bool regexNames(const DbusToMqttMapping& m) {
+    std::regex service(R"(^[a-zA-Z_][a-zA-Z0-9_]*(\.[a-zA-Z_][a-zA-Z0-9_]*)+$)");
+    std::regex path(R"(^(/[a-zA-Z0-9_]+)+$)");
+    std::regex member(R"(^[a-zA-Z_][a-zA-Z0-9_]*$)");
+    std::regex topic(R"(^[a-zA-Z0-9/_+#-]+$)");
+    return std::regex_match(m.service, service) && std::regex_match(m.path, path) &&
+           std::regex_match(m.interface, service) && std::regex_match(m.signal, member) &&
+           std::regex_match(m.topic, topic);
+}
+
+bool scannerNames(const DbusToMqttMapping& m) {
+    return ConfigValidator::validateDbusServiceName(m.service) &&
+           ConfigValidator::validateDbusObjectPath(m.path) &&
+           ConfigValidator::validateDbusInterfaceName(m.interface) &&
+           ConfigValidator::validateDbusMemberName(m.signal) &&
+           ConfigValidator::validateMqttTopic(m.topic, false);
+}
+
+template <typename F>
+double elapsedMs(F f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t mappings = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 20000;
+    Config config = makeConfig(mappings);
+
+    size_t regexValid = 0, scannerValid = 0;
+    double regexMs = elapsedMs([&] {
+        for (const auto& m : config.dbus_to_mqtt) regexValid += regexNames(m);
+    });
+    double scannerMs = elapsedMs([&] {
+        for (const auto& m : config.dbus_to_mqtt) scannerValid += scannerNames(m);
+    });
+
+    ValidationResult serial, parallel;
+    double serialMs   = elapsedMs([&] { serial = config.validate(1); });
+    unsigned threads  = std::max(1u, std::thread::hardware_concurrency());
+    double parallelMs = elapsedMs([&] { parallel = config.validate(threads); });
+
+    std::cout << "mappings: " << mappings << " dbus_to_mqtt + " << mappings << " mqtt_to_dbus\n"
+              << "name checks, regex:   " << regexMs   << " ms (" << regexValid   << " valid)\n"
+              << "name checks, scanner: " << scannerMs << " ms (" << scannerValid << " valid)\n"
+              << "validate(), serial:   " << serialMs  << " ms (" << serial.errors.size() << " errors)\n"
+              << "validate(), " << threads << " threads: " << parallelMs << " ms ("
+              << parallel.errors.size() << " errors)" << std::endl;
+    return serial.errors.size() == parallel.errors.size() ? 0 : 1;
+}
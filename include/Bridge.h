@@ -5,10 +5,20 @@
 #include "MqttManager.h"
 #include <nlohmann/json.hpp>
 #include <memory>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+class Reactor;
 
 class Bridge {
 public:
-    Bridge(const Config& config);
+    // With a non-null `reactor` (event_loop: reactor) the D-Bus connection and
+    // the MQTT reconnect timer are driven by that reactor; the caller runs it.
+    Bridge(const Config& config, Reactor* reactor = nullptr);
 
     // Wires up callbacks, launches the MQTT reconnect thread (non-blocking),
     // and starts the D-Bus event loop asynchronously.
@@ -18,10 +28,94 @@ public:
     // The D-Bus event loop winds down with the connection on destruction.
     void stop();
 
+    // Applies a new, already validated configuration without restarting.
+    // Only mappings that were added or removed touch D-Bus or the broker;
+    // the MQTT → D-Bus routing table is swapped atomically.  Changes to the
+    // broker, bus type or event loop are reported and require a restart.
+    void reload(const Config& newConfig);
+
+    // MQTT filter → QoS the bridge subscribes to for `config`, covering
+    // filters included when optimize_subscriptions is set.
+    static std::map<std::string, int> subscriptions(const Config& config);
+
 private:
-    void onMqttMessage(const std::string& topic, const std::string& payload);
+    // MQTT topic → mapping.  Immutable once published; readers take a
+    // snapshot so a reload never blocks message dispatch.  Exact topics are
+    // a hash lookup; mappings with '+'/'#' in their topic are tried in
+    // configuration order when no exact topic matches.
+    struct RoutingTable {
+        std::unordered_map<std::string, MqttToDbusMapping> exact;
+        std::vector<MqttToDbusMapping>                      wildcard;
+
+        const MqttToDbusMapping* find(const std::string& topic) const;
+    };
+
+    static std::shared_ptr<const RoutingTable> buildRoutes(const std::vector<MqttToDbusMapping>& mappings);
+
+    // Prefixes of every topic the configuration publishes to; see
+    // MqttManager::setPublishPrefixes().
+    static std::vector<std::string> publishPrefixes(const Config& config);
+
+    // Where the answer to one request goes: the MQTT 5 response topic if the
+    // request had one, otherwise the mapping's reply_topic.
+    struct ReplyTo {
+        std::string    topic;            // empty: no reply, only log
+        std::string    correlationData;  // MQTT 5 correlation data, echoed as-is
+        nlohmann::json id;               // "id" from a request envelope, echoed
+
+        // The caller can match replies to requests, so they are wrapped.
+        bool correlated() const { return !correlationData.empty() || !id.is_null(); }
+    };
+
+    // Requests are dispatched asynchronously and answered from the D-Bus
+    // reply callback, so many can be in flight on one MQTT connection.
+    void onMqttMessage(const std::string& topic, const std::string& payload,
+                       const MessageProperties& props);
+
+    // Publishes {"id", "result"} or {"id", "error"} to `to`, or logs the
+    // outcome when there is nowhere to reply.
+    void sendReply(const ReplyTo& to, const std::string& requestTopic,
+                   nlohmann::json result, const std::string& error);
+
+    // Publish topic for a signal with a plain (non-template) topic: the
+    // mapping's topic, extended with the concrete path/member for wildcard
+    // mappings.  Template topics are rendered by TopicTemplate instead.
+    static std::string signalTopic(const DbusToMqttMapping& mapping, const SignalSource& source);
+
+    // Retained topic for one mirrored property: "<topic>[/<subpath>]/<Property>",
+    // or the rendered template.
+    static void propertyTopic(const PropertiesToMqttMapping& mapping, const std::string& path,
+                              const std::string& property, std::string& out);
+
+    // Publishes one dbus_to_mqtt or properties_to_mqtt message.  With
+    // on_change, a payload that hashes the same as the last one MqttManager
+    // accepted for `topic` is skipped until `heartbeat` seconds (0 = never)
+    // have passed; a dropped message is not remembered.
+    void publishMapped(const std::string& topic, const std::string& payload, int qos,
+                       bool retain, bool onChange, int heartbeat);
+    // Lets every on_change topic publish its next payload.
+    void forgetPublished();
+
+    // Appends the part of `path` below `pathNamespace` (if any) to `topic`.
+    static void appendSubpath(std::string& topic, const std::string& pathNamespace,
+                              const std::string& path);
 
     Config                       config_;
     std::unique_ptr<DbusManager> dbusManager_;
     std::unique_ptr<MqttManager> mqttManager_;
+
+    std::atomic<std::shared_ptr<const RoutingTable>> routes_;
+    // Messages that matched a subscription but no mapping; with
+    // optimize_subscriptions this is what the covering filters over-fetch.
+    std::atomic<uint64_t>        unrouted_{0};
+
+    // Last payload sent per on_change topic.  Only a 64-bit hash is kept, so
+    // memory does not grow with payload size.
+    struct LastPublished {
+        uint64_t                              hash;
+        std::chrono::steady_clock::time_point at;
+    };
+    std::mutex                                     lastPublishedMutex_;
+    std::unordered_map<std::string, LastPublished> lastPublished_;
+    std::atomic<uint64_t>                          suppressed_{0};
 };
\ No newline at end of file
@@ -7,6 +7,7 @@
 
 enum class CLIMode {
     RUN_BRIDGE,
+    PRINT_SUBSCRIPTIONS,
     GENERATE_CONFIG,
     HELP,
     VERSION,
@@ -5,21 +5,109 @@
 
 #include <string>
 #include <vector>
+#include <compare>
+#include <map>
 #include "ConfigValidator.h"
+#include "TopicTemplate.h"
 
 struct MqttConfig {
     std::string broker;
     int port = 1883;
     std::string username;
     std::string password;
+
+    // Fallback brokers as "host" or "host:port" (default port: `port`),
+    // tried after `broker`.  failover is "priority" (always start from the
+    // top of the list) or "round_robin" (each attempt starts one further).
+    std::vector<std::string> brokers;
+    std::string failover = "priority";
+
+    // Protocol version: 3 (MQTT 3.1.1, default) or 5.  The settings below
+    // only take effect with version 5.
+    int version = 3;
+    // Seconds the broker may hold an undelivered message; 0 = no expiry.
+    int message_expiry = 0;
+    // Seconds the session outlives a disconnect; 0 = ends with the connection.
+    int session_expiry = 0;
+    // Outbound topic aliases to assign, capped by the broker's limit.
+    int topic_aliases = 16;
+    // Attached to every published message.
+    std::map<std::string, std::string> user_properties;
+
+    // QoS 1/2 messages awaiting acknowledgement; 0 = no flow control.
+    int max_inflight = 1000;
+    // What happens to a message while the window is full: "queue" (default),
+    // "conflate" (keep only the newest queued message per topic) or "drop".
+    std::string overflow_policy = "queue";
+    // Bound on messages held by "queue"/"conflate"; the oldest go first.
+    int max_queued = 10000;
+
+    // Parallel broker connections.  Outbound topics are spread across them
+    // by hash (so each topic keeps its order); subscriptions use the first.
+    // Flow control and topic aliases apply per connection.
+    int connections = 1;
+    // Subscribe to covering "<prefix>/#" filters instead of one filter per
+    // mqtt_to_dbus topic where many topics share a prefix.
+    bool optimize_subscriptions = false;
+    // Where startup phase timings are published (retained JSON) once the
+    // bridge is fully up; empty = not published.
+    std::string metrics_topic;
+
+    // Splits "host[:port]"; false if the port is not a number.
+    static bool splitAddress(const std::string& entry, int defaultPort,
+                             std::string& host, int& port);
+    // tcp:// URIs of `broker` followed by `brokers`, in configured order.
+    std::vector<std::string> serverUris() const;
+
+    bool operator==(const MqttConfig&) const = default;
 };
 
 struct DbusToMqttMapping {
+    std::string service;         // optional: empty matches any sender
+    std::string path;            // exactly one of path / path_namespace
+    std::string path_namespace;  // matches this path and everything below it
+    std::string interface;
+    std::string signal;          // optional: empty matches every member
+    std::string topic;
+    int qos = 1;
+    bool retain = false;
+    // Skip a publish whose payload equals the last one sent to the same
+    // topic; `heartbeat` seconds (0 = never) force a republish anyway.
+    bool on_change = false;
+    int heartbeat = 0;
+    // Compiled form of `topic` when it contains placeholders such as
+    // {path} or {arg0}; empty for plain topics.
+    TopicTemplate topic_template;
+
+    // Wildcard mappings are installed as a single bus match rule instead of
+    // a per-object proxy.  Unless the topic is a template, it is extended
+    // with the concrete object path and/or member of each signal.
+    bool isWildcard() const {
+        return service.empty() || signal.empty() || !path_namespace.empty();
+    }
+
+    // Mappings are compared field-by-field; hot reload uses this to diff the
+    // running and the new mapping sets.
+    auto operator<=>(const DbusToMqttMapping&) const = default;
+};
+
+// Mirrors the properties of one D-Bus interface: each property is published
+// to its own retained topic, "<topic>/<Property>" (with the path below
+// path_namespace inserted before the property name), or wherever the topic
+// template puts {property}.  Driven by PropertiesChanged signals.
+struct PropertiesToMqttMapping {
     std::string service;
-    std::string path;
+    std::string path;            // exactly one of path / path_namespace
+    std::string path_namespace;
     std::string interface;
-    std::string signal;
     std::string topic;
+    TopicTemplate topic_template;
+    int qos = 1;
+    bool retain = true;          // topics hold the current value
+    bool on_change = false;      // as in DbusToMqttMapping
+    int heartbeat = 0;
+
+    auto operator<=>(const PropertiesToMqttMapping&) const = default;
 };
 
 struct MqttToDbusMapping {
@@ -27,23 +115,46 @@ struct MqttToDbusMapping {
     std::string service;
     std::string path;
     std::string interface;
+    // "call" (default) invokes `method` with the payload as arguments;
+    // "get" / "set" read or write `property` instead.
+    std::string action = "call";
     std::string method;
+    std::string property;
+    // Where "get" publishes the property value.
+    std::string reply_topic;
+    // Subscription QoS for `topic`.
+    int qos = 1;
+
+    auto operator<=>(const MqttToDbusMapping&) const = default;
 };
 
 struct Config {
     MqttConfig mqtt;
     std::string bus_type = "system";
+    // "threaded" (default) or "reactor": run D-Bus dispatch, reconnect timers
+    // and signal handling on a single epoll loop in the main thread.
+    std::string event_loop = "threaded";
+    // Reload automatically when the config file changes (inotify).  SIGHUP
+    // always triggers a reload regardless of this setting.
+    bool watch_config = false;
     std::vector<DbusToMqttMapping> dbus_to_mqtt;
+    std::vector<PropertiesToMqttMapping> properties_to_mqtt;
     std::vector<MqttToDbusMapping> mqtt_to_dbus;
 
     static Config loadFromFile(const std::string& filename);
+    static Config loadFromString(const std::string& yaml);
+    // A conf.d fragment: only the `mappings` section, everything else empty.
+    static Config loadFragment(const std::string& yaml);
     
-    // Validation
-    ValidationResult validate() const;
+    // Validation.  `threads` spreads the per-mapping checks over that many
+    // threads (1 = serial); 0 picks serial for small configs and one thread
+    // per core for large ones.  The result is the same either way.
+    ValidationResult validate(unsigned threads = 0) const;
     
 private:
     ValidationResult validateMqttConfig() const;
-    ValidationResult validateMappings() const;
+    ValidationResult validateMappings(unsigned threads) const;
     ValidationResult validateDbusToMqttMapping(const DbusToMqttMapping& mapping, size_t index) const;
+    ValidationResult validatePropertiesToMqttMapping(const PropertiesToMqttMapping& mapping, size_t index) const;
     ValidationResult validateMqttToDbusMapping(const MqttToDbusMapping& mapping, size_t index) const;
 };
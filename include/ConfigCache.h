@@ -0,0 +1,46 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2026 Ed Lee
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include "Config.h"
+#include "ConfigFragments.h"
+#include "ConfigValidator.h"
+
+// Binary snapshot of a parsed, validated Config, keyed by a hash of the YAML
+// text it came from, conf.d fragments included.  Parsing and validating a
+// config with tens of thousands of mappings takes seconds on small gateways;
+// reading the snapshot back is a single mmap and a linear decode.
+//
+// Snapshots live in $CACHE_DIRECTORY (set by systemd's CacheDirectory=),
+// else $XDG_CACHE_HOME/dbus-mqtt-bridge or ~/.cache/dbus-mqtt-bridge, one
+// file per config path, readable only by the owner since they hold the
+// broker credentials.  Only configs without validation errors are cached.
+class ConfigCache {
+public:
+    // Loads `path` like Config::loadFromFile(), merges `fragments` and
+    // validates the result, but returns the snapshot instead when it was
+    // written for the same YAML text by the same build.  `validation`
+    // receives the stored warnings then.  A missing or unwritable cache
+    // directory only costs the speedup.
+    static Config load(const std::string& path, ConfigFragments& fragments,
+                       ValidationResult& validation);
+
+    // The snapshot format.  decode() returns nullopt on a hash, version or
+    // format mismatch and on truncated or corrupt data.
+    static std::string encode(const Config& config, const ValidationResult& validation,
+                              uint64_t hash);
+    static std::optional<Config> decode(std::string_view data, uint64_t hash,
+                                        ValidationResult& validation);
+
+    // 64-bit FNV-1a.
+    static uint64_t hash(std::string_view data);
+
+private:
+    static std::string directory();
+    static std::string snapshotPath(const std::string& configPath);
+};
@@ -0,0 +1,55 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2026 Ed Lee
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <string>
+#include "Config.h"
+#include "ConfigValidator.h"
+
+// Mapping fragments in a conf.d/ directory next to the main config file, so
+// that packages and teams can drop in their own mappings.  Each *.yaml or
+// *.yml file holds only a `mappings:` section; fragments are appended to the
+// main file's mappings in file-name order.
+//
+// Parsed fragments are kept between reloads and a file is only parsed again
+// when its content changes, so a reload costs in proportion to what changed.
+class ConfigFragments {
+public:
+    explicit ConfigFragments(std::string directory);
+
+    // "<directory of configPath>/conf.d"
+    static std::string directoryFor(const std::string& configPath);
+
+    const std::string& directory() const { return directory_; }
+
+    // Re-reads the directory listing and any file whose size or mtime
+    // changed.  Returns a hash of every fragment's name and content; it is 0
+    // when there are no fragments.
+    uint64_t scan();
+
+    // Parses the fragments changed since the last merge, in parallel, and
+    // appends the mappings of all fragments to `config`.  Fragments that fail
+    // to parse and mappings claiming an MQTT topic already taken by another
+    // file are reported in `result` and left out.
+    void merge(Config& config, ValidationResult& result);
+
+private:
+    struct Fragment {
+        std::filesystem::file_time_type mtime;
+        uintmax_t                       size = 0;
+        uint64_t                        hash = 0;
+        std::string                     yaml;    // held until parsed
+        bool                            parsed = false;
+        std::string                     error;
+        Config                          mappings;
+    };
+
+    void parseChanged();
+
+    std::string                     directory_;
+    std::map<std::string, Fragment> fragments_;  // by file name: merge order
+};
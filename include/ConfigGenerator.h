@@ -45,6 +45,10 @@ private:
     static bool promptDbusService(std::string& result, const std::string& current, bool& system_bus);
     static bool promptDbusPath(std::string& result, const std::string& service, 
                                const std::string& current, bool system_bus);
+    // Crawls the service's object tree and lets the user pick a path from
+    // the members matching `query` (false: nothing picked).
+    static bool searchDbusPath(std::string& result, const std::string& service,
+                               const std::string& query, bool system_bus);
     static bool promptDbusInterface(std::string& result, const std::string& service,
                                     const std::string& path, const std::string& current,
                                     bool system_bus);
@@ -47,6 +47,11 @@ public:
     static bool validateDbusInterfaceName(const std::string& interface);
     static bool validateDbusMemberName(const std::string& member);
     static bool validateBusType(const std::string& bus_type);
+    static bool validateEventLoop(const std::string& event_loop);
+    static bool validateMappingAction(const std::string& action);
+    static bool validateQos(int qos);
+    static bool validateOverflowPolicy(const std::string& policy);
+    static bool validateFailover(const std::string& failover);
     
     // Format validation helpers
     static bool isValidHostname(const std::string& hostname);
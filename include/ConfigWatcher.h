@@ -0,0 +1,42 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2026 Ed Lee
+
+#pragma once
+
+#include <string>
+#include <chrono>
+
+// Watches a config file for changes with inotify.
+//
+// The containing directory is watched rather than the file itself so that
+// editors which save by writing a temporary file and renaming it over the
+// original are detected too.  When given a fragment directory (conf.d), any
+// *.yaml / *.yml file created, changed or removed there counts as a change as
+// well; the directory may be created later.
+class ConfigWatcher {
+public:
+    explicit ConfigWatcher(const std::string& path, const std::string& fragmentDir = "");
+    ~ConfigWatcher();
+
+    ConfigWatcher(const ConfigWatcher&) = delete;
+    ConfigWatcher& operator=(const ConfigWatcher&) = delete;
+
+    // Non-blocking inotify fd, for registration with a Reactor.
+    int fd() const { return fd_; }
+
+    // Drains pending events.  Returns true if any of them concerned the
+    // watched file or a fragment.
+    bool consumeEvents();
+
+    // Threaded mode: waits up to `timeout` for a change to the watched file.
+    bool waitForChange(std::chrono::milliseconds timeout);
+
+private:
+    void watchFragments();
+
+    int         fd_ = -1;
+    std::string fileName_;
+    std::string fragmentDir_;
+    std::string fragmentDirName_;   // its name within the config directory
+    int         fragmentWatch_ = -1;
+};
@@ -6,6 +6,8 @@
 #include <string>
 #include <vector>
 #include <map>
+#include "IntrospectionXml.h"
+#include "ObjectIndex.h"
 
 struct BusServices {
     std::vector<std::string> system_services;
@@ -19,12 +21,34 @@ struct IntrospectionData {
     std::vector<std::string> child_paths;
 };
 
+// D-Bus discovery for the config generator.
+//
+// Each bus is connected once, on first use, and the connection is kept for
+// the rest of the process.  Service lists and introspection XML are cached
+// per bus and kept current by a NameOwnerChanged watch, so repeated prompts
+// cost no round trips.  Not thread-safe: the generator is single-threaded.
 class DbusIntrospector {
 public:
     // List services on both buses
     static BusServices listAllServices();
     static std::vector<std::string> listServices(bool system_bus);
     
+    // Full typed description of one object (arguments, properties, ...)
+    static DbusObject introspectObject(
+        const std::string& service,
+        const std::string& path,
+        bool system_bus
+    );
+    
+    // Walks the service's whole object tree from "/", keeping up to
+    // `max_in_flight` asynchronous Introspect calls outstanding, and indexes
+    // every object found.  Objects that fail to introspect are skipped.
+    static ObjectIndex crawl(
+        const std::string& service,
+        bool system_bus,
+        size_t max_in_flight = 32
+    );
+    
     // Introspect a service
     static IntrospectionData introspect(
         const std::string& service,
@@ -52,16 +76,16 @@ public:
     static bool isSessionBusService(const std::string& service);
     
 private:
-    static std::string callIntrospect(
+    struct BusState;
+    static BusState& bus(bool system_bus);
+
+    // Parsed once and cached; a service that appears or goes away drops
+    // its entries.
+    static const DbusObject& object(
         const std::string& service,
         const std::string& path,
         bool system_bus
     );
     
-    static IntrospectionData parseIntrospectionXml(const std::string& xml);
-    static std::vector<std::string> extractElements(
-        const std::string& xml,
-        const std::string& element_name,
-        const std::string& name_attr
-    );
+    static std::vector<std::string> memberNames(const std::vector<DbusMember>& members);
 };
@@ -8,32 +8,105 @@
 #include <atomic>
 #include <mutex>
 #include <set>
+#include <map>
 #include <stdexcept>
+#include <tuple>
 #include "Config.h"
+#include "PropertyCache.h"
+#include "StartupTimings.h"
+
+class Reactor;
+
+// Where a received signal actually came from.  For wildcard mappings this is
+// the only place the concrete object path and member name are available.
+struct SignalSource {
+    std::string sender;     // unique bus name of the emitter
+    std::string path;
+    std::string interface;
+    std::string member;
+};
 
 class DbusManager {
 public:
     using SignalCallback = std::function<void(const DbusToMqttMapping& mapping,
+                                             const SignalSource& source,
                                              const std::vector<sdbus::Variant>& args)>;
-
+    // One call per property whose value changed or was re-fetched.
+    using PropertyCallback = std::function<void(const PropertiesToMqttMapping& mapping,
+                                               const std::string& path,
+                                               const std::string& property,
+                                               const sdbus::Variant& value)>;
+
+    // When `reactor` is non-null the connection is dispatched from that
+    // reactor's thread instead of sdbus-c++'s own event loop thread.
     DbusManager(const std::vector<DbusToMqttMapping>& signalMappings,
-                const std::string& busType = "session");
+                const std::vector<PropertiesToMqttMapping>& propertyMappings,
+                const std::string& busType = "session",
+                Reactor* reactor = nullptr);
 
     // Registers NameOwnerChanged watcher, performs initial service scan,
-    // activates all mappings, and enters the D-Bus event loop asynchronously.
+    // sends the match rules of all mappings without waiting for the daemon,
+    // and enters the D-Bus event loop asynchronously (or hands the bus fd to
+    // the reactor).  Activation is complete, logged and recorded in
+    // StartupTimings once the daemon has answered every rule.
     // Does not throw if individual services are absent at startup.
     void start();
 
     void setSignalCallback(SignalCallback cb);
-
-    // Throws std::runtime_error if the target service is not currently active,
-    // so callers can handle the absence gracefully rather than getting an
-    // opaque sdbus exception.
-    sdbus::Variant callMethod(const std::string& service,
-                              const std::string& path,
-                              const std::string& interface,
-                              const std::string& method,
-                              const std::vector<sdbus::Variant>& args);
+    void setPropertyCallback(PropertyCallback cb);
+
+    // Hot reload: removes the match rules of mappings that are no longer
+    // present and activates the new ones.  Unchanged mappings keep their
+    // rules and never miss a signal.  Returns {added, removed}.
+    std::pair<size_t, size_t> updateMappings(const std::vector<DbusToMqttMapping>& mappings);
+    std::pair<size_t, size_t> updatePropertyMappings(const std::vector<PropertiesToMqttMapping>& mappings);
+
+    // Property access for mqtt_to_dbus "get"/"set" mappings.  Both complete
+    // asynchronously; the error string is empty on success.
+    using PropertyReply      = std::function<void(const sdbus::Variant& value, const std::string& error)>;
+    using CompletionCallback = std::function<void(const std::string& error)>;
+
+    // Read-through: served straight from the property cache when a
+    // properties_to_mqtt mapping or watchProperties() keeps the object fresh,
+    // otherwise an async Properties.Get (cached only if the object is kept
+    // fresh).  `reply` is never called with proxiesMutex_ held.
+    void getProperty(const std::string& service, const std::string& path,
+                     const std::string& interface, const std::string& name,
+                     PropertyReply reply);
+
+    // Async Properties.Set.  Cached properties are updated in the cache
+    // immediately and invalidated again if the call fails.
+    void setProperty(const std::string& service, const std::string& path,
+                     const std::string& interface, const std::string& name,
+                     const sdbus::Variant& value, CompletionCallback done);
+
+    // Subscribes to PropertiesChanged for the object of every "get" mapping
+    // so its cached values stay fresh without being published anywhere;
+    // repeated reads then cost no D-Bus round trip.  Replaces the previous
+    // set, so a reload simply calls it again.
+    void watchProperties(const std::vector<MqttToDbusMapping>& mappings);
+
+    // Last known values of every mirrored property.
+    const PropertyCache& propertyCache() const { return propertyCache_; }
+
+    // Reports every cached mirrored property through the property callback
+    // again.  Called when MQTT (re)connects: values reported while it was
+    // down were dropped, and a restarted broker may have lost its retained
+    // messages.  Safe to call from any thread.
+    void republishProperties();
+
+    // Asynchronous: returns as soon as the call is sent, so any number of
+    // calls can be in flight at once.  `done` receives the reply's values,
+    // or an error (immediately, if the target service is not currently
+    // active), and runs on the D-Bus dispatch thread.
+    using MethodReplyCallback = std::function<void(const std::vector<sdbus::Variant>& results,
+                                                   const std::string& error)>;
+    void callMethod(const std::string& service,
+                    const std::string& path,
+                    const std::string& interface,
+                    const std::string& method,
+                    const std::vector<sdbus::Variant>& args,
+                    MethodReplyCallback done);
 
 private:
     // ── NameOwnerChanged handling ─────────────────────────────────────────────
@@ -42,37 +115,122 @@ private:
     void watchServiceAppearance();
 
     // Called from the NameOwnerChanged handler to update activeServices_ and
-    // re-register proxies when a watched service appears or disappears.
+    // re-snapshot mirrored properties when a watched service appears or
+    // disappears.
     void onNameOwnerChanged(const std::string& name,
                             const std::string& old_owner,
                             const std::string& new_owner);
 
-    // Creates a fresh proxy for a mapping and registers its signal handler.
-    // Catches and logs any sdbus exception so start() does not abort on a
-    // missing service.
+    // Installs the connection-level match rule of a mapping.  The daemon
+    // matches sender='<well-known name>' against the name's current owner,
+    // and wildcard mappings cover every matching object/member, so nothing
+    // has to be redone when the service restarts.  Catches and logs any
+    // sdbus exception so start() does not abort.
     void activateMapping(const DbusToMqttMapping& mapping);
+    static std::string buildMatchRule(const DbusToMqttMapping& mapping);
+
+    void dispatchSignal(const DbusToMqttMapping& mapping, sdbus::Message& message);
+
+    // Sends AddMatch for `rule` without waiting for the reply; `installed`
+    // runs on the dispatch thread once the daemon has answered.  Rules sent
+    // during start() count towards pendingMatches_.
+    sdbus::Slot addMatchAsync(const std::string& rule, sdbus::message_handler handler,
+                              std::function<void()> installed = {});
+    // One startup rule answered (or start() releasing its own count).
+    void matchInstalled();
+
+    // ── property mappings ─────────────────────────────────────────────────────
+
+    // Installs a PropertiesChanged match rule (filtered on arg0 = interface)
+    // and snapshots the properties once the daemon has confirmed it.
+    void activatePropertyMapping(const PropertiesToMqttMapping& mapping);
+    static std::string buildPropertiesMatchRule(const PropertiesToMqttMapping& mapping);
+
+    // Updates the cache from a PropertiesChanged signal, reports each changed
+    // property and fetches the invalidated ones.
+    void onPropertiesChanged(const PropertiesToMqttMapping& mapping, sdbus::Message& message);
+
+    // Async Properties.GetAll for a mapping with a concrete path; every value
+    // is cached and reported.  Run at startup, when the service (re)appears
+    // and when the mapping is added by a reload, so retained topics hold the
+    // current state before the first PropertiesChanged arrives.
+    void snapshotProperties(const PropertiesToMqttMapping& mapping);
+
+    // Async Properties.Get for a property that was invalidated without a value.
+    void fetchProperty(const PropertiesToMqttMapping& mapping,
+                       const std::string& path, const std::string& name);
+    // Serialized with republishProperties() by reportMutex_, so a republished
+    // value can never overtake a newer one reported from the dispatch thread.
+    void reportProperty(const PropertiesToMqttMapping& mapping, const std::string& path,
+                        const std::string& name, const sdbus::Variant& value);
+
+    // Cache-only counterpart of onPropertiesChanged() for watched objects.
+    void onWatchedPropertiesChanged(const std::string& service, const std::string& interface,
+                                    sdbus::Message& message);
+
+    // True if a properties_to_mqtt mapping or a watch keeps this object's
+    // cache entry fresh.  Must be called with proxiesMutex_ held.
+    bool isMirrored(const std::string& service, const std::string& path,
+                    const std::string& interface) const;
+
+    // Proxies used for async method and property calls, one per (service,
+    // path).  They must outlive their pending calls, so they are kept rather
+    // than created per call.  Must be called with proxiesMutex_ held.
+    sdbus::IProxy& callProxy(const std::string& service, const std::string& path);
+
+    // Reactor mode: registers the bus fd and a prepare hook that drains
+    // queued messages and keeps the watched events/timeout in sync with sd-bus.
+    void attachToReactor();
+    void processPendingRequests();
 
     // ── data members ──────────────────────────────────────────────────────────
     std::string                                      busType_;
     std::unique_ptr<sdbus::IConnection>              connection_;
+    Reactor*                                         reactor_ = nullptr;
+    int                                              busFd_   = -1;
 
     // Proxy to org.freedesktop.DBus, held alive for the NameOwnerChanged watch.
     std::unique_ptr<sdbus::IProxy>                   busProxy_;
 
-    // Signal-handler proxies for each activated mapping.
-    // Guarded by proxiesMutex_ because activateMapping() can be called from
-    // the D-Bus event thread (via onNameOwnerChanged) after start().
-    std::vector<std::unique_ptr<sdbus::IProxy>>      proxies_;
+    // Guards the mapping state below; the D-Bus event thread touches it from
+    // NameOwnerChanged and match-install callbacks after start().
     std::mutex                                       proxiesMutex_;
 
-    // Well-known names currently active on the bus.
-    // Guarded by proxiesMutex_ (same lock as proxies_ for simplicity).
+    // Match-rule registration for each activated mapping, keyed by the
+    // mapping itself so re-activation replaces rather than duplicates a rule
+    // and a reload can drop exactly the mappings that went away.  Destroying
+    // a slot removes the rule from the daemon.  Guarded by proxiesMutex_.
+    std::map<DbusToMqttMapping, sdbus::Slot>         matchSlots_;
+
+    // Well-known names currently active on the bus.  Guarded by proxiesMutex_.
     std::set<std::string>                            activeServices_;
 
     SignalCallback                                   signalCallback_;
-    std::vector<DbusToMqttMapping>                   mappings_;
+    std::vector<DbusToMqttMapping>                   mappings_;  // guarded by proxiesMutex_
+
+    // properties_to_mqtt match rules and the async call proxies, guarded by
+    // proxiesMutex_.  The cache has its own lock.
+    PropertyCallback                                 propertyCallback_;
+    std::vector<PropertiesToMqttMapping>             propertyMappings_;
+    std::map<PropertiesToMqttMapping, sdbus::Slot>   propertySlots_;
+    std::map<std::pair<std::string, std::string>, std::unique_ptr<sdbus::IProxy>> callProxies_;
+    PropertyCache                                    propertyCache_;
+    std::mutex                                       reportMutex_;
+
+    // watchProperties() match rules per (service, path, interface), guarded
+    // by proxiesMutex_.  An object is only in watched_ once the daemon has
+    // installed its rule; before that no change could be missed.
+    using ObjectKey = std::tuple<std::string, std::string, std::string>;
+    std::map<ObjectKey, sdbus::Slot>                 watchSlots_;
+    std::set<ObjectKey>                              watched_;
 
     // Set to true after enterEventLoopAsync(); used to distinguish the initial
     // startup phase from callbacks fired later by the event loop.
     std::atomic<bool>                                started_{false};
+
+    // Startup match rules not yet answered by the daemon, plus one held by
+    // start() while it is still sending them.
+    std::atomic<size_t>                              pendingMatches_{0};
+    size_t                                           startupMatches_ = 0;
+    StartupTimings::Clock::time_point                activationStart_;
 };
\ No newline at end of file
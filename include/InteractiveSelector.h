@@ -6,12 +6,16 @@
 #include <string>
 #include <vector>
 #include <optional>
+#include <cstdint>
 
 class InteractiveSelector {
 public:
     // Show interactive list with cursor navigation
     // Returns selected item or nullopt if cancelled
     // Special return values: "<<UP>>" for left arrow, "<<SELECT>>" for descend
+    // Typing filters the list to items containing the typed characters in
+    // order (case-insensitive); '/' starts a filter beginning with q or m,
+    // Backspace widens it again and Esc clears it.
     static std::optional<std::string> selectFromList(
         const std::string& title,
         const std::vector<std::string>& items,
@@ -33,6 +37,31 @@ public:
     static std::string promptPassword(const std::string& question);
     
 private:
+    // Incremental subsequence filter.  Each level holds the items matching
+    // one more character, with where in the item that match ended, so
+    // typing a character only rescans the survivors from that point and
+    // Backspace just drops a level.
+    class Filter {
+    public:
+        explicit Filter(const std::vector<std::string>& items);
+        void push(char c);
+        void pop();
+        void clear();
+        const std::string& text() const { return text_; }
+        size_t size() const;
+        // Index into the original items of the n-th match
+        size_t at(size_t n) const;
+        
+    private:
+        struct Match {
+            uint32_t item;
+            uint32_t end;   // one past the last matched character
+        };
+        const std::vector<std::string>& items_;
+        std::string text_;
+        std::vector<std::vector<Match>> levels_;   // levels_[k]: first k+1 chars
+    };
+    
     static void initNcurses();
     static void cleanupNcurses();
 };
@@ -0,0 +1,51 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2026 Ed Lee
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Typed model of one object's org.freedesktop.DBus.Introspectable XML.
+struct DbusArg {
+    std::string name;        // may be empty
+    std::string type;        // D-Bus signature
+    std::string direction;   // "in" or "out"; signal arguments are "out"
+};
+
+struct DbusMember {
+    std::string          name;
+    std::vector<DbusArg> args;
+};
+
+struct DbusProperty {
+    std::string name;
+    std::string type;
+    std::string access;      // "read", "write" or "readwrite"
+};
+
+struct DbusInterface {
+    std::string               name;
+    std::vector<DbusMember>   methods;
+    std::vector<DbusMember>   signals;
+    std::vector<DbusProperty> properties;
+};
+
+struct DbusObject {
+    std::vector<DbusInterface> interfaces;
+    std::vector<std::string>   children;   // relative names of child nodes
+
+    const DbusInterface* findInterface(std::string_view name) const;
+};
+
+namespace IntrospectionXml {
+
+// Single pass over the document.  Tags and attributes are scanned in place
+// as string_views; only the names and types kept in the model are copied.
+// Interfaces of nested <node> elements are not attributed to the object,
+// only their names are listed as children.  Throws std::runtime_error on
+// an unterminated tag, comment or quoted value.
+DbusObject parse(std::string_view xml);
+
+} // namespace IntrospectionXml
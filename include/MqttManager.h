@@ -9,28 +9,102 @@
 #include <thread>
 #include <mutex>
 #include <condition_variable>
+#include <list>
+#include <map>
+#include <unordered_map>
+#include <chrono>
 #include "Config.h"
+#include "TopicAliasTable.h"
+
+class Reactor;
+
+// Request/response metadata of an incoming MQTT 5 message.  Both fields are
+// empty for MQTT 3.1.1 or when the sender did not set them.
+struct MessageProperties {
+    std::string responseTopic;
+    std::string correlationData;   // opaque bytes, echoed back unchanged
+};
 
 class MqttManager {
 public:
-    using MessageCallback = std::function<void(const std::string& topic, const std::string& payload)>;
+    using MessageCallback = std::function<void(const std::string& topic,
+                                               const std::string& payload,
+                                               const MessageProperties& props)>;
+    using ConnectedCallback = std::function<void()>;
 
-    MqttManager(const MqttConfig& config, const std::vector<MqttToDbusMapping>& mappings);
+    // When `reactor` is non-null, reconnect scheduling runs on a reactor
+    // timer and connection attempts are asynchronous instead of using a
+    // dedicated reconnect thread.
+    //
+    // With mqtt.connections > 1 this instance is connection 0 and owns the
+    // others as publish-only shards; the public API hides the difference.
+    MqttManager(const MqttConfig& config, const std::vector<MqttToDbusMapping>& mappings,
+                Reactor* reactor = nullptr);
     ~MqttManager();
 
-    // Non-blocking: launches the reconnect thread which attempts the first
-    // connection in the background, retrying with exponential backoff.
+    // Non-blocking: launches the reconnect thread (or arms the reactor's
+    // reconnect timer) which attempts the first connection in the background,
+    // retrying with exponential backoff.
     void connect();
 
     // Stops the reconnect thread, then disconnects from the broker.
     void disconnect();
 
     // Thread-safe: drops the message with a warning if not currently connected.
-    void publish(const std::string& topic, const std::string& payload);
+    // Retained messages are kept by the broker as the topic's current state.
+    // QoS 0 is fire-and-forget: nothing waits for or tracks the delivery, and
+    // messages dropped while disconnected are only counted, not logged.
+    // Returns false if the message was dropped rather than sent or queued.
+    bool publish(const std::string& topic, const std::string& payload,
+                 int qos = 1, bool retain = false);
+
+    // Flow control.  QoS 1/2 messages hold a slot of the in-flight window
+    // (mqtt.max_inflight) until the broker acknowledges them; when it is
+    // full, overflow_policy decides.  Call admit() before building a
+    // message: under "drop" it returns false (and counts the drop) while the
+    // window is full, so no work is spent on a message that would be thrown
+    // away.  "queue" and "conflate" hold messages in a bounded queue that
+    // drains as acknowledgements arrive.  With several connections admit()
+    // only refuses when every window is full; the connection the topic
+    // routes to makes the final decision.
+    bool admit(int qos);
+    size_t inflight() const;
+
+    // Publishes the answer to a request, attaching the request's correlation
+    // data (if any) as the MQTT 5 CORRELATION_DATA property.  Replies are
+    // never conflated or dropped by the overflow policy.
+    void publishReply(const std::string& topic, const std::string& payload,
+                      const std::string& correlationData);
 
     void setMessageCallback(MessageCallback cb);
 
+    // Called after every successful connect of any connection, once
+    // publishing is possible and the subscriptions are in place.  Runs on
+    // the reconnect thread (or the reactor thread); set before connect().
+    void setConnectedCallback(ConnectedCallback cb);
+
+    // Hot reload: subscribes to topics that are new and unsubscribes from
+    // topics no mapping uses any more; other subscriptions are untouched.
+    // Returns {added, removed} topic counts.
+    std::pair<size_t, size_t> updateMappings(const std::vector<MqttToDbusMapping>& mappings);
+
+    // Topic prefixes the bridge publishes below.  With optimize_subscriptions
+    // no covering filter may overlap them, or the bridge would receive its
+    // own messages.  Takes effect with the next subscription update.
+    void setPublishPrefixes(std::vector<std::string> prefixes);
+
+    // Topic → subscription QoS of `mappings`; several mappings may share a
+    // topic, in which case the highest QoS wins.
+    static std::map<std::string, int> mappingTopics(const std::vector<MqttToDbusMapping>& mappings);
+
 private:
+    // Publish-only shard: no subscriptions, client id suffixed with `index`.
+    MqttManager(const MqttConfig& config, Reactor* reactor, int index);
+
+    // Connection that owns `topic`'s outbound traffic.
+    MqttManager& route(const std::string& topic);
+    bool hasRoom();
+
     // ── paho callback handler ─────────────────────────────────────────────────
     class Callback : public virtual mqtt::callback {
         MqttManager& parent_;
@@ -42,24 +116,119 @@ private:
         void delivery_complete(mqtt::delivery_token_ptr token) override;
     };
 
+    // Completion listener for the asynchronous connect used in reactor mode.
+    // Runs on a paho thread, so it only updates state and re-arms the timer.
+    class ConnectListener : public virtual mqtt::iaction_listener {
+        MqttManager& parent_;
+    public:
+        explicit ConnectListener(MqttManager& parent) : parent_(parent) {}
+        void on_success(const mqtt::token& tok) override;
+        void on_failure(const mqtt::token& tok) override;
+    };
+
+    // Completion listener for tracked (QoS 1/2) publishes; frees the
+    // message's in-flight slot whether delivery succeeded or failed.
+    class DeliveryListener : public virtual mqtt::iaction_listener {
+        MqttManager& parent_;
+    public:
+        explicit DeliveryListener(MqttManager& parent) : parent_(parent) {}
+        void on_success(const mqtt::token& tok) override;
+        void on_failure(const mqtt::token& tok) override;
+    };
+
+    // ── flow control ──────────────────────────────────────────────────────────
+
+    enum class Overflow { Queue, Conflate, Drop };
+
+    struct Outgoing {
+        std::string topic;
+        std::string payload;
+        std::string correlationData;
+        int         qos    = 1;
+        bool        retain = false;
+        bool        reply  = false;   // exempt from conflate/drop
+    };
+
+    // Sends now if the window has room, otherwise applies the policy.
+    // Both return false if the message was dropped.
+    bool enqueueOrSend(Outgoing msg);
+    // Must be called with flowMutex_ held.
+    bool queueLocked(Outgoing msg);
+    void drainLocked();
+    void onDelivered();
+
+    // Hands one message to paho.  With MQTT 5 the configured expiry/user
+    // properties and, when one is assigned, a topic alias are attached.
+    void send(const Outgoing& msg, bool tracked);
+
+    // Sizes the alias table from the broker's CONNACK; called on every
+    // successful connect before connected_ is set.
+    void onConnected(const mqtt::token& tok);
+
     // ── reconnect loop helpers ────────────────────────────────────────────────
+
+    // Orders the server list for the next attempt (rotating it under
+    // round_robin failover), stamps the attempt start and returns the URI
+    // tried first, for logging.
+    std::string beginAttempt();
+    // Logs and records how long the attempt (and any outage) took.
+    void recordConnect(const mqtt::token& tok);
+
     void reconnectLoop();
     void doConnect();
+    // After a connect: forgets what the broker knew unless CONNACK reported
+    // a present session, then brings the subscriptions up to date.
     void resubscribe();
+    // Diffs the mappings' topics against subscribed_ and sends the changes
+    // as a few multi-topic SUBSCRIBE/UNSUBSCRIBE packets, waiting once.
+    void syncSubscriptions();
+
+    // Reactor mode: fired on the reactor thread.  Starts an async connect
+    // when disconnected, or performs the subscriptions once connected.
+    void onReconnectTimer();
+    void scheduleReconnect(std::chrono::milliseconds delay);
 
     // ── data members ──────────────────────────────────────────────────────────
     MqttConfig                          config_;
-    std::vector<MqttToDbusMapping>      mappings_;
+    std::vector<MqttToDbusMapping>      mappings_;       // guarded by mappingsMutex_
+    std::vector<std::string>            publishPrefixes_; // guarded by mappingsMutex_
+    std::mutex                          mappingsMutex_;
     std::unique_ptr<mqtt::async_client> client_;
     Callback                            callback_;
+    ConnectListener                     connectListener_;
+    DeliveryListener                    deliveryListener_;
     MessageCallback                     messageCallback_;
+    ConnectedCallback                   connectedCallback_;
 
     // Built once in the constructor and reused on every reconnect attempt.
     mqtt::connect_options               connOpts_;
 
+    // MQTT 5 state.  publishProps_ is immutable after construction; the
+    // alias table is guarded by aliasMutex_, which is also held while the
+    // message is handed to paho so aliased publishes stay in order.
+    bool                                v5_ = false;
+    mqtt::properties                    publishProps_;
+    TopicAliasTable                     aliases_;
+    std::mutex                          aliasMutex_;
+    std::atomic<uint64_t>               topicBytesSaved_{0};
+
     // Set true after a successful connect; cleared by connection_lost.
     // Checked by publish() to avoid calling into a disconnected client.
     std::atomic<bool>                   connected_{false};
+    // QoS 0 messages dropped while disconnected; reported on reconnect.
+    std::atomic<uint64_t>               droppedQos0_{0};
+
+    // Flow control state, guarded by flowMutex_ (taken before aliasMutex_).
+    // pendingByTopic_ indexes conflatable queued messages by topic.
+    Overflow                            overflow_ = Overflow::Queue;
+    size_t                              maxInflight_ = 0;
+    size_t                              maxQueued_ = 0;
+    mutable std::mutex                  flowMutex_;
+    size_t                              inflight_ = 0;
+    std::list<Outgoing>                 pending_;
+    std::unordered_map<std::string, std::list<Outgoing>::iterator> pendingByTopic_;
+    std::atomic<uint64_t>               droppedOverflow_{0};
+    std::atomic<uint64_t>               conflated_{0};
 
     // Reconnect thread state.
     std::thread                         reconnectThread_;
@@ -67,4 +236,42 @@ private:
     std::condition_variable             reconnectCv_;
     bool                                reconnectNeeded_{false};  // guarded by reconnectMutex_
     std::atomic<bool>                   stopReconnect_{false};
+
+    // Topic → QoS the broker session is known to hold, guarded by
+    // subscribeMutex_ (held across a whole sync).  sessionPresent_ comes
+    // from the last CONNACK.
+    std::map<std::string, int>          subscribed_;
+    std::mutex                          subscribeMutex_;
+    std::atomic<bool>                   sessionPresent_{false};
+
+    // Failover.  With more than one URI, connOpts_' server list is rebuilt
+    // by beginAttempt(), which only runs on the connecting thread.
+    std::vector<std::string>            serverUris_;
+    size_t                              nextServer_ = 0;
+
+    // Connect metrics.  attemptStart_ is written before the connect call
+    // whose completion reads it; lostAt_ is zero while connected.
+    // connectCalled_ is the start of the first connect, for StartupTimings.
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point                   connectCalled_;
+    Clock::time_point                   attemptStart_;
+    std::atomic<Clock::rep>             lostAt_{0};
+    std::atomic<unsigned>               attempts_{0};
+    std::atomic<uint64_t>               connects_{0};
+    std::atomic<uint64_t>               connectMsTotal_{0};
+    std::atomic<uint64_t>               connectMsMax_{0};
+
+    // Connections 1..N-1 (empty unless mqtt.connections > 1).  index_ is
+    // this connection's number; only connection 0 subscribes and feeds
+    // StartupTimings.
+    std::vector<std::unique_ptr<MqttManager>> shards_;
+    int                                 index_ = 0;
+
+    // Reactor mode state.  retryDelayMs_ holds the previous retry delay and
+    // is only touched from paho's callback thread or the reactor thread,
+    // never both at once; the timer may be armed from any thread.
+    Reactor*                            reactor_ = nullptr;
+    int                                 reconnectTimer_ = -1;
+    std::atomic<long>                   retryDelayMs_{0};
+    std::atomic<bool>                   connecting_{false};
 };
\ No newline at end of file
@@ -0,0 +1,37 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2026 Ed Lee
+
+#pragma once
+
+#include "IntrospectionXml.h"
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// In-memory index of a crawled object tree: path → interfaces → members.
+class ObjectIndex {
+public:
+    enum class MemberKind { Method, Signal, Property };
+
+    struct Hit {
+        std::string path;
+        std::string interface;
+        std::string member;
+        MemberKind  kind;
+    };
+
+    void add(const std::string& path, DbusObject object);
+
+    // Members whose "<path> <interface>.<member>" contains `needle`,
+    // ignoring case, in path order.  The standard org.freedesktop.DBus.*
+    // interfaces every object carries are skipped unless the needle names
+    // them.  Stops after `limit` hits.
+    std::vector<Hit> search(std::string_view needle, size_t limit = 500) const;
+
+    const std::map<std::string, DbusObject>& objects() const { return objects_; }
+    size_t size() const { return objects_.size(); }
+
+private:
+    std::map<std::string, DbusObject> objects_;
+};
@@ -0,0 +1,58 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2026 Ed Lee
+
+#pragma once
+
+#include <sdbus-c++/sdbus-c++.h>
+#include <compare>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+
+// Last known property values per (service, object path, interface), kept
+// current from PropertiesChanged signals.  Values are stored as received;
+// sdbus::Variant has no equality, so callers that need change detection
+// compare the serialized form themselves.
+//
+// Thread-safe: written from the D-Bus dispatch thread, read from MQTT
+// callbacks.
+class PropertyCache {
+public:
+    using Properties = std::map<std::string, sdbus::Variant>;
+
+    void set(const std::string& service, const std::string& path,
+             const std::string& interface, const std::string& name,
+             const sdbus::Variant& value);
+
+    // Forgets a property whose value was invalidated without being sent.
+    void invalidate(const std::string& service, const std::string& path,
+                    const std::string& interface, const std::string& name);
+
+    std::optional<sdbus::Variant> get(const std::string& service, const std::string& path,
+                                      const std::string& interface, const std::string& name) const;
+
+    // Copy of every cached property of one object interface.
+    Properties getAll(const std::string& service, const std::string& path,
+                      const std::string& interface) const;
+
+    // Copy of every cached object of `service` that has `interface`, keyed
+    // by object path.
+    std::map<std::string, Properties> objects(const std::string& service,
+                                              const std::string& interface) const;
+
+    // Drops every object of `service`, e.g. when it leaves the bus.
+    void dropService(const std::string& service);
+
+private:
+    struct ObjectKey {
+        std::string service;
+        std::string path;
+        std::string interface;
+
+        auto operator<=>(const ObjectKey&) const = default;
+    };
+
+    mutable std::mutex               mutex_;
+    std::map<ObjectKey, Properties>  objects_;
+};
@@ -0,0 +1,68 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2026 Ed Lee
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+#include <atomic>
+
+// Single-threaded epoll event loop used by the "reactor" event_loop mode.
+//
+// Everything the bridge would otherwise spread across helper threads — the
+// sd-bus connection fd, reconnect/batching timers and process signals — is
+// multiplexed on the thread that calls run().  All registration methods must
+// be called from that thread (or before run()), except armTimer(),
+// disarmTimer() and stop(), which are safe to call from any thread.
+class Reactor {
+public:
+    using Handler       = std::function<void()>;
+    using SignalHandler = std::function<void(int signo)>;
+    // Called before every epoll_wait().  Returns the longest the loop may
+    // sleep in milliseconds, or -1 for no limit.
+    using PrepareHook   = std::function<int()>;
+
+    Reactor();
+    ~Reactor();
+
+    Reactor(const Reactor&) = delete;
+    Reactor& operator=(const Reactor&) = delete;
+
+    // Level-triggered fd watches.  `events` is an EPOLLIN/EPOLLOUT mask.
+    void addFd(int fd, uint32_t events, Handler handler);
+    void modifyFd(int fd, uint32_t events);
+    void removeFd(int fd);
+
+    // One-shot timers backed by a timerfd.  addTimer() returns an id that is
+    // passed to armTimer()/disarmTimer()/removeTimer().  Arming an armed
+    // timer replaces its deadline; a zero delay fires on the next iteration.
+    int  addTimer(Handler handler);
+    void armTimer(int timer, std::chrono::milliseconds delay);
+    void disarmTimer(int timer);
+    void removeTimer(int timer);
+
+    // Blocks `signals` in the calling thread (and therefore in every thread
+    // created afterwards) and delivers them through a signalfd instead.
+    // Must be called before any other threads are started.
+    void watchSignals(const std::vector<int>& signals, SignalHandler handler);
+
+    void addPrepareHook(PrepareHook hook);
+
+    // Dispatches events until stop() is called.
+    void run();
+    void stop();
+
+private:
+    int                                     epollFd_  = -1;
+    int                                     wakeFd_   = -1;  // eventfd poked by stop()
+    int                                     signalFd_ = -1;
+
+    std::unordered_map<int, Handler>        handlers_;
+    std::vector<int>                        timers_;
+    std::vector<PrepareHook>                prepareHooks_;
+    SignalHandler                           signalHandler_;
+    std::atomic<bool>                       running_{false};
+};
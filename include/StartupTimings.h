@@ -0,0 +1,57 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2026 Ed Lee
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+
+// Durations of the startup phases, to see what dominates a restart.
+//
+// Phases finish on different threads (MQTT connects and subscribes in the
+// background), so recording is thread-safe.  Only the first record of a
+// phase counts: reconnects and reloads do not overwrite the startup figures.
+// When the last phase comes in, the summary is printed and passed as JSON to
+// the completion callback.
+class StartupTimings {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    enum class Phase {
+        ConfigSearch,
+        ConfigLoad,         // YAML parse, or reading the config snapshot
+        Validation,         // 0 when the snapshot was used
+        DbusConnect,
+        ListNames,
+        MappingActivation,  // until the daemon has answered every match rule
+        MqttConnect,        // from connect() to the first CONNACK, retries included
+        MqttSubscribe,
+        Count
+    };
+
+    // The clock for "total" starts with the first call.
+    static StartupTimings& instance();
+
+    void record(Phase phase, Clock::duration elapsed);
+    void record(Phase phase, Clock::time_point since) { record(phase, Clock::now() - since); }
+
+    // Called once, from the thread that records the last phase.
+    void onComplete(std::function<void(const std::string& json)> callback);
+
+    // {"startup_ms":{"config_search":0.05,...,"total":812.4}}; phases not
+    // recorded yet are left out.
+    std::string toJson() const;
+
+private:
+    StartupTimings() = default;
+
+    mutable std::mutex                                         mutex_;
+    Clock::time_point                                          start_ = Clock::now();
+    std::array<std::optional<double>, size_t(Phase::Count)>    ms_;
+    std::optional<double>                                      totalMs_;
+    std::function<void(const std::string&)>                    onComplete_;
+};
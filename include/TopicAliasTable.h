@@ -0,0 +1,66 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2026 Ed Lee
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+// Outbound MQTT 5 topic aliases for one connection.
+//
+// A topic gets an alias once it has been published kHotThreshold times, so
+// one-off topics (e.g. RPC reply topics) never take a slot.  The first
+// publish after assignment carries the topic and the alias, which teaches
+// the broker the mapping; later publishes send only the two-byte alias.
+// Aliases are per connection, so reset() must be called on every connect.
+//
+// Publish counts decay by half at regular intervals, so they track recent
+// rates.  Once every alias is taken, a topic that has become busier than
+// the coldest aliased one takes over its alias (MQTT 5 allows remapping an
+// alias to another topic).  At most one alias moves per interval.
+//
+// Not thread-safe: the caller serializes lookups with the publishes they
+// decide, so an alias-only message can never overtake the one that
+// establishes the alias.
+class TopicAliasTable {
+public:
+    struct Assignment {
+        uint16_t alias = 0;      // 0: publish without an alias
+        bool     known = false;  // broker already has it: omit the topic
+    };
+
+    void reset(uint16_t maxAliases);
+
+    Assignment lookup(const std::string& topic);
+
+    uint16_t capacity() const { return maxAliases_; }
+
+private:
+    static constexpr unsigned kHotThreshold = 2;
+    // Bound on topics tracked while not aliased; templated topics can be
+    // unbounded.  Decay drops the cold ones, and if that is not enough the
+    // counts are restarted.
+    static constexpr size_t   kMaxCandidates = 4096;
+    // Lookups between decays, plus one per aliased topic so the decay pass
+    // stays amortized O(1).
+    static constexpr unsigned kDecayInterval = 1024;
+
+    struct Entry {
+        uint16_t alias = 0;
+        bool     known = false;
+        unsigned hits  = 0;
+    };
+
+    // Halves every count and picks the coldest aliased topic as the next
+    // eviction victim.
+    void decay();
+
+    uint16_t                                  maxAliases_ = 0;
+    // Wider than an alias so it cannot wrap to 0 after alias 65535.
+    uint32_t                                  nextAlias_  = 1;
+    size_t                                    lookups_    = 0;
+    std::unordered_map<std::string, Entry>    aliased_;
+    std::unordered_map<std::string, unsigned> candidates_;
+    std::string                               victim_;     // empty: none chosen
+};
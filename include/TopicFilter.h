@@ -0,0 +1,30 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2026 Ed Lee
+
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// MQTT topic filter helpers: matching and subscription-set minimization.
+namespace TopicFilter {
+
+// True if `topic` (no wildcards) matches `filter` under MQTT rules: '+'
+// matches one level, a trailing '#' the parent level and everything below,
+// and wildcards in the first level never match topics starting with '$'.
+bool matches(std::string_view filter, std::string_view topic);
+
+// Replaces groups of subscriptions sharing a prefix by one "<prefix>/#"
+// filter.  A prefix qualifies when it has at least `minLevels` levels,
+// covers at least `minTopics` subscriptions and does not overlap any of
+// `excluded`: topic prefixes the bridge publishes below, which it must not
+// receive back ("#" excludes everything).  Covering filters get the highest
+// QoS of the group.
+std::map<std::string, int> cover(const std::map<std::string, int>& topics,
+                                 const std::vector<std::string>& excluded,
+                                 size_t minTopics = 4, size_t minLevels = 2);
+
+} // namespace TopicFilter
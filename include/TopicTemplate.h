@@ -0,0 +1,69 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2026 Ed Lee
+
+#pragma once
+
+#include <compare>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <nlohmann/json_fwd.hpp>
+
+// Values available to a template when a signal is published.
+struct TopicContext {
+    std::string_view service;     // mapping's service, or the sender if unset
+    std::string_view sender;      // unique bus name of the emitter
+    std::string_view path;
+    std::string_view interface;
+    std::string_view member;
+    std::string_view property;    // properties_to_mqtt mappings only
+    const nlohmann::json* args = nullptr;  // decoded signal arguments (array)
+};
+
+// An outbound topic such as "dbus/{service}/{path}/{member}" or
+// "sensors/{arg0}", split once at config load into literal and placeholder
+// segments.  Rendering walks the segments and appends into a caller-owned
+// buffer, so the per-message cost is a handful of appends.
+//
+// Placeholders: {service} {sender} {path} {interface} {member} {property}
+// {argN}.
+// {path} drops the leading '/', so "dbus/{path}" yields "dbus/org/...".
+class TopicTemplate {
+public:
+    enum class Kind : uint8_t { Literal, Service, Sender, Path, Interface, Member, Property, Arg };
+
+    struct Segment {
+        Kind        kind = Kind::Literal;
+        std::string text;       // Literal only
+        unsigned    arg  = 0;   // Arg only
+
+        auto operator<=>(const Segment&) const = default;
+    };
+
+    TopicTemplate() = default;
+
+    // True if `topic` contains placeholders and therefore needs compiling.
+    static bool isTemplate(std::string_view topic);
+
+    // Returns nullopt and fills `error` for unbalanced braces or unknown
+    // placeholders.
+    static std::optional<TopicTemplate> parse(std::string_view topic, std::string* error = nullptr);
+
+    bool empty() const { return segments_.empty(); }
+    const std::vector<Segment>& segments() const { return segments_; }
+
+    // Replaces the contents of `out` with the rendered topic.  MQTT wildcard
+    // characters coming from argument values are replaced with '_'.
+    void render(const TopicContext& ctx, std::string& out) const;
+
+    // The template with every placeholder replaced by `filler`; used to
+    // validate the literal parts as an MQTT topic.
+    std::string sample(std::string_view filler = "x") const;
+
+    auto operator<=>(const TopicTemplate&) const = default;
+
+private:
+    std::vector<Segment> segments_;
+};
@@ -169,7 +169,9 @@ inline sdbus::Variant jsonToVariant(const nlohmann::json& j) {
 
 // ── unpackSignal ──────────────────────────────────────────────────────────────
 
-inline std::vector<sdbus::Variant> unpackSignal(sdbus::Signal& signal) {
+// Accepts any message so it serves both proxy signal handlers and raw
+// match-rule callbacks (wildcard mappings).
+inline std::vector<sdbus::Variant> unpackSignal(sdbus::Message& signal) {
     std::vector<sdbus::Variant> args;
     int safety_limit = 100;
     while (safety_limit-- > 0) {
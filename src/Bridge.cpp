@@ -2,14 +2,74 @@
 // Copyright (C) 2026 Ed Lee
 
 #include "Bridge.h"
+#include "ConfigCache.h"
+#include "TopicFilter.h"
+#include "StartupTimings.h"
 #include "TypeUtils.h"
 #include <iostream>
 
-Bridge::Bridge(const Config& config)
+Bridge::Bridge(const Config& config, Reactor* reactor)
     : config_(config)
 {
-    dbusManager_ = std::make_unique<DbusManager>(config_.dbus_to_mqtt, config_.bus_type);
-    mqttManager_ = std::make_unique<MqttManager>(config_.mqtt, config_.mqtt_to_dbus);
+    dbusManager_ = std::make_unique<DbusManager>(config_.dbus_to_mqtt, config_.properties_to_mqtt,
+                                                 config_.bus_type, reactor);
+    mqttManager_ = std::make_unique<MqttManager>(config_.mqtt, config_.mqtt_to_dbus, reactor);
+    mqttManager_->setPublishPrefixes(publishPrefixes(config_));
+    routes_.store(buildRoutes(config_.mqtt_to_dbus));
+
+    if (!config_.mqtt.metrics_topic.empty()) {
+        StartupTimings::instance().onComplete([this, topic = config_.mqtt.metrics_topic](const std::string& json) {
+            mqttManager_->publish(topic, json, 1, true);
+        });
+    }
+}
+
+std::shared_ptr<const Bridge::RoutingTable> Bridge::buildRoutes(
+    const std::vector<MqttToDbusMapping>& mappings)
+{
+    auto routes = std::make_shared<RoutingTable>();
+    for (const auto& mapping : mappings) {
+        if (mapping.topic.find_first_of("+#") != std::string::npos) {
+            routes->wildcard.push_back(mapping);
+        } else {
+            routes->exact.emplace(mapping.topic, mapping);
+        }
+    }
+    return routes;
+}
+
+const MqttToDbusMapping* Bridge::RoutingTable::find(const std::string& topic) const {
+    auto it = exact.find(topic);
+    if (it != exact.end()) return &it->second;
+    for (const auto& mapping : wildcard) {
+        if (TopicFilter::matches(mapping.topic, topic)) return &mapping;
+    }
+    return nullptr;
+}
+
+std::map<std::string, int> Bridge::subscriptions(const Config& config) {
+    auto topics = MqttManager::mappingTopics(config.mqtt_to_dbus);
+    if (!config.mqtt.optimize_subscriptions || topics.empty()) return topics;
+    return TopicFilter::cover(topics, publishPrefixes(config));
+}
+
+std::vector<std::string> Bridge::publishPrefixes(const Config& config) {
+    // Templates publish anywhere below their literal head ("#" if they start
+    // with a placeholder); plain topics may be extended with subpaths.
+    auto prefixOf = [](const std::string& topic, const TopicTemplate& tpl) -> std::string {
+        if (tpl.empty()) return topic;
+        auto slash = topic.rfind('/', topic.find('{'));
+        return slash == std::string::npos ? "#" : topic.substr(0, slash);
+    };
+
+    std::vector<std::string> prefixes;
+    for (const auto& m : config.dbus_to_mqtt)       prefixes.push_back(prefixOf(m.topic, m.topic_template));
+    for (const auto& m : config.properties_to_mqtt) prefixes.push_back(prefixOf(m.topic, m.topic_template));
+    for (const auto& m : config.mqtt_to_dbus) {
+        if (!m.reply_topic.empty()) prefixes.push_back(m.reply_topic);
+    }
+    if (!config.mqtt.metrics_topic.empty()) prefixes.push_back(config.mqtt.metrics_topic);
+    return prefixes;
 }
 
 void Bridge::start() {
@@ -18,21 +78,67 @@ void Bridge::start() {
     // not-connected case internally and logs a warning if the broker is down.
     dbusManager_->setSignalCallback(
         [this](const DbusToMqttMapping& mapping,
+               const SignalSource& source,
                const std::vector<sdbus::Variant>& args)
         {
+            // Under overflow_policy "drop" a full window rejects the message
+            // before any encoding work is done.
+            if (!mqttManager_->admit(mapping.qos)) return;
+
             nlohmann::json j = nlohmann::json::array();
             for (const auto& arg : args) {
                 j.push_back(TypeUtils::variantToJson(arg));
             }
-            mqttManager_->publish(mapping.topic, j.dump());
+            // Reused per thread so steady-state rendering does not allocate.
+            thread_local std::string topic;
+            if (!mapping.topic_template.empty()) {
+                TopicContext ctx;
+                ctx.service   = mapping.service.empty() ? source.sender : mapping.service;
+                ctx.sender    = source.sender;
+                ctx.path      = source.path;
+                ctx.interface = source.interface;
+                ctx.member    = source.member;
+                ctx.args      = &j;
+                mapping.topic_template.render(ctx, topic);
+            } else {
+                topic = signalTopic(mapping, source);
+            }
+            publishMapped(topic, j.dump(), mapping.qos, mapping.retain,
+                          mapping.on_change, mapping.heartbeat);
+        });
+
+    // Mirrored properties: one message per property, retained by default so
+    // a consumer subscribing later immediately gets the current value.
+    dbusManager_->setPropertyCallback(
+        [this](const PropertiesToMqttMapping& mapping,
+               const std::string& path,
+               const std::string& property,
+               const sdbus::Variant& value)
+        {
+            if (!mqttManager_->admit(mapping.qos)) return;
+
+            thread_local std::string topic;
+            propertyTopic(mapping, path, property, topic);
+            publishMapped(topic, TypeUtils::variantToJson(value).dump(), mapping.qos,
+                          mapping.retain, mapping.on_change, mapping.heartbeat);
         });
 
     // Wire up the MQTT → D-Bus message callback.
     mqttManager_->setMessageCallback(
-        [this](const std::string& topic, const std::string& payload) {
-            this->onMqttMessage(topic, payload);
+        [this](const std::string& topic, const std::string& payload,
+               const MessageProperties& props) {
+            this->onMqttMessage(topic, payload, props);
         });
 
+    // The startup snapshot usually completes before the broker answers, and
+    // publish() drops messages while disconnected: (re)send the cached state
+    // once a connection is up so the retained topics always get it.  The
+    // broker may have lost what on_change assumes it still holds.
+    mqttManager_->setConnectedCallback([this] {
+        forgetPublished();
+        dbusManager_->republishProperties();
+    });
+
     // MqttManager::connect() is now non-blocking: it launches a reconnect
     // thread that attempts the first connection in the background, retrying
     // with exponential backoff if the broker is unavailable.
@@ -43,43 +149,229 @@ void Bridge::start() {
     // asynchronously.  A NameOwnerChanged watcher inside DbusManager activates
     // and deactivates per-mapping proxies as services come and go.
     dbusManager_->start();
+    // After start(), so these rules do not hold up the startup summary.
+    dbusManager_->watchProperties(config_.mqtt_to_dbus);
+}
+
+std::string Bridge::signalTopic(const DbusToMqttMapping& mapping, const SignalSource& source) {
+    if (!mapping.isWildcard()) return mapping.topic;
+
+    // Wildcard mappings fan out: append the part of the object path below
+    // the namespace, then the member name if the mapping matches any signal.
+    //   topic "systemd/units", path_namespace "/org/freedesktop/systemd1/unit"
+    //   → systemd/units/ssh_2eservice/PropertiesChanged
+    std::string topic = mapping.topic;
+    appendSubpath(topic, mapping.path_namespace, source.path);
+    if (mapping.signal.empty()) {
+        topic += '/';
+        topic += source.member;
+    }
+    return topic;
+}
+
+void Bridge::propertyTopic(const PropertiesToMqttMapping& mapping, const std::string& path,
+                           const std::string& property, std::string& out) {
+    if (!mapping.topic_template.empty()) {
+        TopicContext ctx;
+        ctx.service   = mapping.service;
+        ctx.path      = path;
+        ctx.interface = mapping.interface;
+        ctx.member    = "PropertiesChanged";
+        ctx.property  = property;
+        mapping.topic_template.render(ctx, out);
+        return;
+    }
+    out = mapping.topic;
+    appendSubpath(out, mapping.path_namespace, path);
+    out += '/';
+    out += property;
+}
+
+void Bridge::appendSubpath(std::string& topic, const std::string& pathNamespace,
+                           const std::string& path) {
+    if (pathNamespace.empty()) return;
+    size_t skip = (pathNamespace == "/") ? 0 : pathNamespace.size();
+    if (path.size() > skip + 1) {
+        topic.append(path, skip);
+    }
+}
+
+void Bridge::publishMapped(const std::string& topic, const std::string& payload, int qos,
+                           bool retain, bool onChange, int heartbeat) {
+    if (!onChange) {
+        mqttManager_->publish(topic, payload, qos, retain);
+        return;
+    }
+
+    // Fixed 64 bits (FNV-1a) on every target: a collision would silently
+    // drop a real state change.
+    uint64_t hash = ConfigCache::hash(payload);
+    auto now = std::chrono::steady_clock::now();
+    {
+        std::lock_guard<std::mutex> lock(lastPublishedMutex_);
+        auto it = lastPublished_.find(topic);
+        if (it != lastPublished_.end() && it->second.hash == hash &&
+            (heartbeat <= 0 || now - it->second.at < std::chrono::seconds(heartbeat))) {
+            ++suppressed_;
+            return;
+        }
+    }
+    // Only what the broker can actually get counts as published.
+    if (!mqttManager_->publish(topic, payload, qos, retain)) return;
+
+    std::lock_guard<std::mutex> lock(lastPublishedMutex_);
+    lastPublished_[topic] = {hash, now};
+}
+
+void Bridge::forgetPublished() {
+    std::lock_guard<std::mutex> lock(lastPublishedMutex_);
+    lastPublished_.clear();
 }
 
 void Bridge::stop() {
+    StartupTimings::instance().onComplete(nullptr);
     mqttManager_->disconnect();
+    if (uint64_t unrouted = unrouted_.load()) {
+        std::cout << "MQTT messages without a matching mapping: " << unrouted << std::endl;
+    }
+    if (uint64_t suppressed = suppressed_.load()) {
+        std::cout << "Unchanged payloads not republished (on_change): " << suppressed << std::endl;
+    }
     // DbusManager's event loop is tied to the connection lifetime and will
     // wind down when the connection object is destroyed (in the destructor).
 }
 
-void Bridge::onMqttMessage(const std::string& topic, const std::string& payload) {
-    for (const auto& mapping : config_.mqtt_to_dbus) {
-        if (mapping.topic == topic) {
-            try {
-                auto j = nlohmann::json::parse(payload);
-                std::vector<sdbus::Variant> args;
-                if (j.is_array()) {
-                    for (const auto& item : j) {
-                        args.push_back(TypeUtils::jsonToVariant(item));
-                    }
-                } else {
-                    args.push_back(TypeUtils::jsonToVariant(j));
-                }
+void Bridge::reload(const Config& newConfig) {
+    if (!(newConfig.mqtt == config_.mqtt)) {
+        std::cerr << "Reload: MQTT broker settings changed; restart required to apply them" << std::endl;
+    }
+    if (newConfig.bus_type != config_.bus_type || newConfig.event_loop != config_.event_loop) {
+        std::cerr << "Reload: bus_type/event_loop changed; restart required to apply them" << std::endl;
+    }
 
-                auto result = dbusManager_->callMethod(
-                    mapping.service, mapping.path,
-                    mapping.interface, mapping.method, args);
+    // Publish the new routing table before subscribing so messages on new
+    // topics have somewhere to go; topics being dropped simply stop matching.
+    routes_.store(buildRoutes(newConfig.mqtt_to_dbus));
+    mqttManager_->setPublishPrefixes(publishPrefixes(newConfig));
+    auto [subsAdded, subsRemoved] = mqttManager_->updateMappings(newConfig.mqtt_to_dbus);
+    auto [sigsAdded, sigsRemoved] = dbusManager_->updateMappings(newConfig.dbus_to_mqtt);
+    auto [propsAdded, propsRemoved] = dbusManager_->updatePropertyMappings(newConfig.properties_to_mqtt);
+    dbusManager_->watchProperties(newConfig.mqtt_to_dbus);
 
-                std::cout << "Method call result: "
-                          << TypeUtils::variantToJson(result).dump() << std::endl;
+    // A changed mapping may publish differently; let every topic send once.
+    forgetPublished();
+    config_.dbus_to_mqtt = newConfig.dbus_to_mqtt;
+    config_.properties_to_mqtt = newConfig.properties_to_mqtt;
+    config_.mqtt_to_dbus = newConfig.mqtt_to_dbus;
+    config_.watch_config = newConfig.watch_config;
+
+    std::cout << "Reload complete: dbus_to_mqtt +" << sigsAdded << "/-" << sigsRemoved
+              << ", properties_to_mqtt +" << propsAdded << "/-" << propsRemoved
+              << ", mqtt_to_dbus topics +" << subsAdded << "/-" << subsRemoved << std::endl;
+}
 
-            } catch (const std::exception& e) {
-                // callMethod throws if the service is currently absent.
-                // Log it and carry on — the mapping will work again once the
-                // service reappears and NameOwnerChanged reactivates it.
-                std::cerr << "Error processing MQTT message for topic "
-                          << topic << ": " << e.what() << std::endl;
+void Bridge::onMqttMessage(const std::string& topic, const std::string& payload,
+                           const MessageProperties& props) {
+    // Snapshot the routing table; a concurrent reload swaps in a new one
+    // without waiting for this dispatch to finish.
+    auto routes = routes_.load();
+    const MqttToDbusMapping* route = routes->find(topic);
+    if (!route) {
+        ++unrouted_;
+        return;
+    }
+    const auto& mapping = *route;
+
+    ReplyTo replyTo;
+    replyTo.topic = props.responseTopic.empty() ? mapping.reply_topic : props.responseTopic;
+    replyTo.correlationData = props.correlationData;
+
+    // A request may be wrapped as {"id": ..., "args": [...]} (call) or
+    // {"id": ..., "value": ...} (set); the id is echoed in the reply.  Any
+    // other payload is the arguments / value itself.  Gets need no payload.
+    nlohmann::json body;
+    try {
+        if (!payload.empty()) body = nlohmann::json::parse(payload);
+    } catch (const std::exception& e) {
+        sendReply(replyTo, topic, nullptr, std::string("invalid JSON payload: ") + e.what());
+        return;
+    }
+    if (body.is_object() && body.contains("id")) {
+        replyTo.id = body["id"];
+        body = body.value(mapping.action == "set" ? "value" : "args", nlohmann::json());
+    }
+
+    if (mapping.action == "get") {
+        // Served from the property cache when possible.  Uncorrelated reads
+        // get the bare value, like a state topic.
+        dbusManager_->getProperty(mapping.service, mapping.path, mapping.interface, mapping.property,
+            [this, topic, replyTo](const sdbus::Variant& value, const std::string& error) {
+                if (error.empty() && !replyTo.correlated()) {
+                    mqttManager_->publish(replyTo.topic, TypeUtils::variantToJson(value).dump());
+                    return;
+                }
+                sendReply(replyTo, topic, error.empty() ? TypeUtils::variantToJson(value) : nullptr, error);
+            });
+        return;
+    }
+
+    try {
+        if (mapping.action == "set") {
+            dbusManager_->setProperty(mapping.service, mapping.path, mapping.interface, mapping.property,
+                TypeUtils::jsonToVariant(body),
+                [this, topic, replyTo](const std::string& error) {
+                    sendReply(replyTo, topic, nullptr, error);
+                });
+            return;
+        }
+
+        std::vector<sdbus::Variant> args;
+        if (body.is_array()) {
+            for (const auto& item : body) {
+                args.push_back(TypeUtils::jsonToVariant(item));
             }
-            break;
+        } else if (!body.is_null()) {
+            args.push_back(TypeUtils::jsonToVariant(body));
         }
+
+        dbusManager_->callMethod(
+            mapping.service, mapping.path,
+            mapping.interface, mapping.method, args,
+            [this, topic, replyTo](const std::vector<sdbus::Variant>& results, const std::string& error) {
+                // No return value → null, one → the value, several → array.
+                nlohmann::json result;
+                if (results.size() == 1) {
+                    result = TypeUtils::variantToJson(results.front());
+                } else if (results.size() > 1) {
+                    result = nlohmann::json::array();
+                    for (const auto& r : results) result.push_back(TypeUtils::variantToJson(r));
+                }
+                sendReply(replyTo, topic, std::move(result), error);
+            });
+
+    } catch (const std::exception& e) {
+        sendReply(replyTo, topic, nullptr, e.what());
+    }
+}
+
+void Bridge::sendReply(const ReplyTo& to, const std::string& requestTopic,
+                       nlohmann::json result, const std::string& error) {
+    if (!error.empty()) {
+        // The service may simply be absent; the mapping works again once it
+        // reappears and NameOwnerChanged marks it active.
+        std::cerr << "Error processing MQTT message for topic "
+                  << requestTopic << ": " << error << std::endl;
     }
-}
\ No newline at end of file
+    if (to.topic.empty()) {
+        if (error.empty() && !result.is_null()) {
+            std::cout << "Method call result: " << result.dump() << std::endl;
+        }
+        return;
+    }
+
+    nlohmann::json reply = nlohmann::json::object();
+    if (!to.id.is_null()) reply["id"] = to.id;
+    if (error.empty()) reply["result"] = std::move(result);
+    else               reply["error"]  = error;
+    mqttManager_->publishReply(to.topic, reply.dump(), to.correlationData);
+}
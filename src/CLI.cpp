@@ -24,6 +24,10 @@ CLIMode CLI::parseArguments(int argc, char** argv) {
             return CLIMode::GENERATE_CONFIG;
         }
         
+        if (arg == "--print-subscriptions") {
+            return CLIMode::PRINT_SUBSCRIPTIONS;
+        }
+        
         // Check for unknown flags
         if (arg[0] == '-' && arg != "-o" && arg != "--from") {
             showError("Unknown option: " + arg);
@@ -45,6 +49,8 @@ void CLI::showHelp(const std::string& program_name) {
               << "  --generate-config     Interactive configuration generator\n"
               << "                        Use with --from FILE to edit existing config\n"
               << "                        Use with -o FILE to specify output path\n"
+              << "  --print-subscriptions Validate the config and list the MQTT\n"
+              << "                        subscriptions it results in\n"
               << "\n"
               << "Arguments:\n"
               << "  CONFIG_FILE           Path to configuration file\n"
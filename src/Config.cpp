@@ -6,9 +6,183 @@
 #include <yaml-cpp/yaml.h>
 #include <stdexcept>
 #include <sstream>
+#include <algorithm>
+#include <string_view>
+#include <thread>
+#include <unordered_set>
 
-Config Config::loadFromFile(const std::string& filename) {
-    YAML::Node node = YAML::LoadFile(filename);
+namespace {
+
+// Below this many mappings validate() stays on the calling thread; thread
+// start-up costs more than checking a few thousand mappings.
+constexpr size_t kParallelThreshold = 4096;
+
+void append(ValidationResult& into, const ValidationResult& from) {
+    into.errors.insert(into.errors.end(), from.errors.begin(), from.errors.end());
+    into.warnings.insert(into.warnings.end(), from.warnings.begin(), from.warnings.end());
+    if (from.hasErrors()) into.valid = false;
+}
+
+// Runs check(mapping, index) over `mappings` split into contiguous chunks,
+// one per thread, then merges the chunk results in index order so the
+// report is identical to a serial run.
+template <typename Mapping, typename Check>
+void validateEach(ValidationResult& result, const std::vector<Mapping>& mappings,
+                  unsigned threads, Check check) {
+    size_t chunks = std::min<size_t>(std::max(threads, 1u), mappings.size());
+    if (chunks <= 1) {
+        for (size_t i = 0; i < mappings.size(); ++i) append(result, check(mappings[i], i));
+        return;
+    }
+
+    std::vector<ValidationResult> partial(chunks);
+    std::vector<std::thread> workers;
+    workers.reserve(chunks);
+    size_t per = (mappings.size() + chunks - 1) / chunks;
+    for (size_t c = 0; c < chunks; ++c) {
+        workers.emplace_back([&, c] {
+            size_t end = std::min(mappings.size(), (c + 1) * per);
+            for (size_t i = c * per; i < end; ++i) append(partial[c], check(mappings[i], i));
+        });
+    }
+    for (auto& worker : workers) worker.join();
+    for (const auto& part : partial) append(result, part);
+}
+
+// Templates are compiled once at load; a malformed one is left empty and
+// reported by validate().
+TopicTemplate compileTopic(const std::string& topic) {
+    if (TopicTemplate::isTemplate(topic)) {
+        if (auto tpl = TopicTemplate::parse(topic)) return std::move(*tpl);
+    }
+    return {};
+}
+
+// Publish topics: templates must only use known placeholders, and the
+// literal parts must still form a valid topic without wildcards.
+void validatePublishTopic(ValidationResult& result, const std::string& field,
+                          const std::string& topic) {
+    if (TopicTemplate::isTemplate(topic)) {
+        std::string error;
+        auto tpl = TopicTemplate::parse(topic, &error);
+        if (!tpl) {
+            result.addError(field,
+                "Invalid topic template '" + topic + "': " + error +
+                ". Supported placeholders: {service} {sender} {path} {interface} {member} {property} {argN}");
+        } else if (!ConfigValidator::validateMqttTopic(tpl->sample(), false)) {
+            result.addError(field, 
+                "Invalid MQTT topic template '" + topic + 
+                "'. Wildcards (+, #) are not allowed in publish topics");
+        }
+    } else if (!ConfigValidator::validateMqttTopic(topic, false)) {
+        result.addError(field, 
+            "Invalid MQTT topic '" + topic + 
+            "'. Wildcards (+, #) are not allowed in publish topics");
+    }
+}
+
+void validateOnChange(ValidationResult& result, const std::string& prefix,
+                      bool onChange, int heartbeat) {
+    if (heartbeat < 0) {
+        result.addError(prefix + ".heartbeat", 
+            "Invalid heartbeat " + std::to_string(heartbeat) + ". Must be 0 (off) or a number of seconds");
+    } else if (heartbeat > 0 && !onChange) {
+        result.addWarning(prefix + ".heartbeat has no effect without 'on_change: true'");
+    }
+}
+
+} // namespace
+
+bool MqttConfig::splitAddress(const std::string& entry, int defaultPort,
+                              std::string& host, int& port) {
+    auto colon = entry.rfind(':');
+    if (colon == std::string::npos) {
+        host = entry;
+        port = defaultPort;
+        return true;
+    }
+    host = entry.substr(0, colon);
+    std::string digits = entry.substr(colon + 1);
+    if (digits.empty() || digits.size() > 5 ||
+        digits.find_first_not_of("0123456789") != std::string::npos) {
+        return false;
+    }
+    port = std::stoi(digits);
+    return true;
+}
+
+std::vector<std::string> MqttConfig::serverUris() const {
+    std::vector<std::string> uris;
+    uris.push_back("tcp://" + broker + ":" + std::to_string(port));
+    for (const auto& entry : brokers) {
+        std::string host;
+        int entryPort;
+        if (!splitAddress(entry, port, host, entryPort)) continue;  // rejected by validate()
+        uris.push_back("tcp://" + host + ":" + std::to_string(entryPort));
+    }
+    return uris;
+}
+
+namespace {
+
+void parseMappings(const YAML::Node& mappings, Config& config) {
+    if (mappings["dbus_to_mqtt"]) {
+        for (auto m : mappings["dbus_to_mqtt"]) {
+            // service, signal and path_namespace are optional (wildcard
+            // mappings); validate() checks the combination.
+            DbusToMqttMapping mapping;
+            if (m["service"])        mapping.service        = m["service"].as<std::string>();
+            if (m["path"])           mapping.path           = m["path"].as<std::string>();
+            if (m["path_namespace"]) mapping.path_namespace = m["path_namespace"].as<std::string>();
+            mapping.interface = m["interface"].as<std::string>();
+            if (m["signal"])         mapping.signal         = m["signal"].as<std::string>();
+            mapping.topic = m["topic"].as<std::string>();
+            mapping.topic_template = compileTopic(mapping.topic);
+            if (m["qos"])    mapping.qos    = m["qos"].as<int>();
+            if (m["retain"]) mapping.retain = m["retain"].as<bool>();
+            if (m["on_change"]) mapping.on_change = m["on_change"].as<bool>();
+            if (m["heartbeat"]) mapping.heartbeat = m["heartbeat"].as<int>();
+            config.dbus_to_mqtt.push_back(std::move(mapping));
+        }
+    }
+
+    if (mappings["properties_to_mqtt"]) {
+        for (auto m : mappings["properties_to_mqtt"]) {
+            PropertiesToMqttMapping mapping;
+            mapping.service = m["service"].as<std::string>();
+            if (m["path"])           mapping.path           = m["path"].as<std::string>();
+            if (m["path_namespace"]) mapping.path_namespace = m["path_namespace"].as<std::string>();
+            mapping.interface = m["interface"].as<std::string>();
+            mapping.topic = m["topic"].as<std::string>();
+            mapping.topic_template = compileTopic(mapping.topic);
+            if (m["qos"])    mapping.qos    = m["qos"].as<int>();
+            if (m["retain"]) mapping.retain = m["retain"].as<bool>();
+            if (m["on_change"]) mapping.on_change = m["on_change"].as<bool>();
+            if (m["heartbeat"]) mapping.heartbeat = m["heartbeat"].as<int>();
+            config.properties_to_mqtt.push_back(std::move(mapping));
+        }
+    }
+
+    if (mappings["mqtt_to_dbus"]) {
+        for (auto m : mappings["mqtt_to_dbus"]) {
+            // method is only required for "call"; property and
+            // reply_topic only for "get"/"set".  validate() checks.
+            MqttToDbusMapping mapping;
+            mapping.topic     = m["topic"].as<std::string>();
+            mapping.service   = m["service"].as<std::string>();
+            mapping.path      = m["path"].as<std::string>();
+            mapping.interface = m["interface"].as<std::string>();
+            if (m["action"])      mapping.action      = m["action"].as<std::string>();
+            if (m["method"])      mapping.method      = m["method"].as<std::string>();
+            if (m["property"])    mapping.property    = m["property"].as<std::string>();
+            if (m["reply_topic"]) mapping.reply_topic = m["reply_topic"].as<std::string>();
+            if (m["qos"])         mapping.qos         = m["qos"].as<int>();
+            config.mqtt_to_dbus.push_back(std::move(mapping));
+        }
+    }
+}
+
+Config fromYaml(const YAML::Node& node) {
     Config config;
 
     if (!node["mqtt"]) throw std::runtime_error("Missing 'mqtt' section in config");
@@ -16,62 +190,92 @@ Config Config::loadFromFile(const std::string& filename) {
     auto mqtt = node["mqtt"];
     config.mqtt.broker = mqtt["broker"].as<std::string>();
     config.mqtt.port = mqtt["port"].as<int>(1883);
+    if (mqtt["brokers"]) {
+        for (const auto& entry : mqtt["brokers"]) {
+            config.mqtt.brokers.push_back(entry.as<std::string>());
+        }
+    }
+    if (mqtt["failover"]) config.mqtt.failover = mqtt["failover"].as<std::string>();
 
     if (node["bus_type"]) {
         config.bus_type = node["bus_type"].as<std::string>();
     }
 
+    if (node["event_loop"]) {
+        config.event_loop = node["event_loop"].as<std::string>();
+    }
+
+    if (node["watch_config"]) {
+        config.watch_config = node["watch_config"].as<bool>();
+    }
+
+    if (mqtt["version"])        config.mqtt.version        = mqtt["version"].as<int>();
+    if (mqtt["message_expiry"]) config.mqtt.message_expiry = mqtt["message_expiry"].as<int>();
+    if (mqtt["session_expiry"]) config.mqtt.session_expiry = mqtt["session_expiry"].as<int>();
+    if (mqtt["topic_aliases"])  config.mqtt.topic_aliases  = mqtt["topic_aliases"].as<int>();
+    if (mqtt["max_inflight"])    config.mqtt.max_inflight    = mqtt["max_inflight"].as<int>();
+    if (mqtt["overflow_policy"]) config.mqtt.overflow_policy = mqtt["overflow_policy"].as<std::string>();
+    if (mqtt["max_queued"])      config.mqtt.max_queued      = mqtt["max_queued"].as<int>();
+    if (mqtt["connections"])     config.mqtt.connections     = mqtt["connections"].as<int>();
+    if (mqtt["metrics_topic"])   config.mqtt.metrics_topic   = mqtt["metrics_topic"].as<std::string>();
+    if (mqtt["optimize_subscriptions"]) {
+        config.mqtt.optimize_subscriptions = mqtt["optimize_subscriptions"].as<bool>();
+    }
+    if (mqtt["user_properties"]) {
+        for (const auto& prop : mqtt["user_properties"]) {
+            config.mqtt.user_properties[prop.first.as<std::string>()] = prop.second.as<std::string>();
+        }
+    }
+
     if (mqtt["auth"]) {
         auto auth = mqtt["auth"];
         if (auth["username"]) config.mqtt.username = auth["username"].as<std::string>();
         if (auth["password"]) config.mqtt.password = auth["password"].as<std::string>();
     }
 
-    if (node["mappings"]) {
-        auto mappings = node["mappings"];
-        
-        if (mappings["dbus_to_mqtt"]) {
-            for (auto m : mappings["dbus_to_mqtt"]) {
-                config.dbus_to_mqtt.push_back({
-                    m["service"].as<std::string>(),
-                    m["path"].as<std::string>(),
-                    m["interface"].as<std::string>(),
-                    m["signal"].as<std::string>(),
-                    m["topic"].as<std::string>()
-                });
-            }
-        }
+    if (node["mappings"]) parseMappings(node["mappings"], config);
 
-        if (mappings["mqtt_to_dbus"]) {
-            for (auto m : mappings["mqtt_to_dbus"]) {
-                config.mqtt_to_dbus.push_back({
-                    m["topic"].as<std::string>(),
-                    m["service"].as<std::string>(),
-                    m["path"].as<std::string>(),
-                    m["interface"].as<std::string>(),
-                    m["method"].as<std::string>()
-                });
-            }
+    return config;
+}
+
+} // namespace
+
+Config Config::loadFromFile(const std::string& filename) {
+    return fromYaml(YAML::LoadFile(filename));
+}
+
+Config Config::loadFromString(const std::string& yaml) {
+    return fromYaml(YAML::Load(yaml));
+}
+
+Config Config::loadFragment(const std::string& yaml) {
+    YAML::Node node = YAML::Load(yaml);
+    Config config;
+    if (node.IsNull()) return config;  // empty file
+    if (!node.IsMap()) throw std::runtime_error("Fragment must be a mapping with a 'mappings' section");
+    for (const auto& entry : node) {
+        if (entry.first.as<std::string>() != "mappings") {
+            throw std::runtime_error("Only 'mappings' may be set in a fragment, not '" +
+                                     entry.first.as<std::string>() + "'");
         }
     }
-
+    if (node["mappings"]) parseMappings(node["mappings"], config);
     return config;
 }
 
-ValidationResult Config::validate() const {
+ValidationResult Config::validate(unsigned threads) const {
     ValidationResult result;
     
+    if (threads == 0) {
+        size_t total = dbus_to_mqtt.size() + properties_to_mqtt.size() + mqtt_to_dbus.size();
+        threads = total < kParallelThreshold ? 1 : std::max(1u, std::thread::hardware_concurrency());
+    }
+    
     // Validate MQTT configuration
-    auto mqtt_result = validateMqttConfig();
-    result.errors.insert(result.errors.end(), mqtt_result.errors.begin(), mqtt_result.errors.end());
-    result.warnings.insert(result.warnings.end(), mqtt_result.warnings.begin(), mqtt_result.warnings.end());
-    if (mqtt_result.hasErrors()) result.valid = false;
+    append(result, validateMqttConfig());
     
     // Validate mappings
-    auto mapping_result = validateMappings();
-    result.errors.insert(result.errors.end(), mapping_result.errors.begin(), mapping_result.errors.end());
-    result.warnings.insert(result.warnings.end(), mapping_result.warnings.begin(), mapping_result.warnings.end());
-    if (mapping_result.hasErrors()) result.valid = false;
+    append(result, validateMappings(threads));
     
     return result;
 }
@@ -101,47 +305,117 @@ ValidationResult Config::validateMqttConfig() const {
             "Both username and password must be provided together, or neither");
     }
     
+    // Validate protocol version and MQTT 5 settings
+    if (mqtt.version != 3 && mqtt.version != 5) {
+        result.addError("mqtt.version", 
+            "Invalid MQTT version " + std::to_string(mqtt.version) + ". Must be 3 (3.1.1) or 5");
+    }
+    if (mqtt.message_expiry < 0) {
+        result.addError("mqtt.message_expiry", "message_expiry must not be negative");
+    }
+    if (mqtt.session_expiry < 0) {
+        result.addError("mqtt.session_expiry", "session_expiry must not be negative");
+    }
+    if (mqtt.topic_aliases < 0 || mqtt.topic_aliases > 65535) {
+        result.addError("mqtt.topic_aliases", 
+            "Invalid topic_aliases " + std::to_string(mqtt.topic_aliases) + ". Must be between 0 and 65535");
+    }
+    if (mqtt.version != 5 &&
+        (mqtt.message_expiry > 0 || mqtt.session_expiry > 0 || !mqtt.user_properties.empty())) {
+        result.addWarning("mqtt.message_expiry, session_expiry and user_properties "
+                          "require 'version: 5' and are ignored");
+    }
+    if (mqtt.version == 5 && mqtt.session_expiry > 0 && mqtt.topic_aliases > 0) {
+        result.addWarning("Topic aliases are disabled while session_expiry is set: messages "
+                          "resent after a reconnect cannot use aliases of the old connection");
+    }
+    
+    // Validate fallback brokers
+    for (size_t i = 0; i < mqtt.brokers.size(); ++i) {
+        std::string field = "mqtt.brokers[" + std::to_string(i) + "]";
+        std::string host;
+        int port;
+        if (!MqttConfig::splitAddress(mqtt.brokers[i], mqtt.port, host, port) ||
+            !ConfigValidator::validateMqttPort(port)) {
+            result.addError(field, "Invalid port in broker '" + mqtt.brokers[i] + "'");
+        } else if (!ConfigValidator::validateMqttBroker(host)) {
+            result.addError(field, 
+                "Invalid MQTT broker '" + host + "'. Must be a valid hostname or IP address");
+        }
+    }
+    if (!ConfigValidator::validateFailover(mqtt.failover)) {
+        result.addError("mqtt.failover", 
+            "Invalid failover '" + mqtt.failover + "'. Must be 'priority' or 'round_robin'");
+    }
+    
+    // Validate flow control
+    if (mqtt.max_inflight < 0 || mqtt.max_inflight > 65535) {
+        result.addError("mqtt.max_inflight", 
+            "Invalid max_inflight " + std::to_string(mqtt.max_inflight) + ". Must be between 0 and 65535");
+    }
+    if (!ConfigValidator::validateOverflowPolicy(mqtt.overflow_policy)) {
+        result.addError("mqtt.overflow_policy", 
+            "Invalid overflow_policy '" + mqtt.overflow_policy + "'. Must be 'queue', 'conflate' or 'drop'");
+    }
+    if (mqtt.max_queued < 1) {
+        result.addError("mqtt.max_queued", "max_queued must be at least 1");
+    }
+    if (mqtt.connections < 1 || mqtt.connections > 64) {
+        result.addError("mqtt.connections", 
+            "Invalid connections " + std::to_string(mqtt.connections) + ". Must be between 1 and 64");
+    }
+    if (!mqtt.metrics_topic.empty() && !ConfigValidator::validateMqttTopic(mqtt.metrics_topic, false)) {
+        result.addError("mqtt.metrics_topic", 
+            "Invalid MQTT topic '" + mqtt.metrics_topic + 
+            "'. Wildcards (+, #) are not allowed in publish topics");
+    }
+    
     // Validate bus type
     if (!ConfigValidator::validateBusType(bus_type)) {
         result.addError("bus_type", 
             "Invalid bus_type '" + bus_type + "'. Must be 'system' or 'session'");
     }
     
+    // Validate event loop mode
+    if (!ConfigValidator::validateEventLoop(event_loop)) {
+        result.addError("event_loop", 
+            "Invalid event_loop '" + event_loop + "'. Must be 'threaded' or 'reactor'");
+    }
+    
     return result;
 }
 
-ValidationResult Config::validateMappings() const {
+ValidationResult Config::validateMappings(unsigned threads) const {
     ValidationResult result;
     
     // Warn if no mappings defined
-    if (dbus_to_mqtt.empty() && mqtt_to_dbus.empty()) {
+    if (dbus_to_mqtt.empty() && properties_to_mqtt.empty() && mqtt_to_dbus.empty()) {
         result.addWarning("No mappings defined. Service will run but do nothing.");
     }
     
     // Validate each dbus_to_mqtt mapping
-    for (size_t i = 0; i < dbus_to_mqtt.size(); ++i) {
-        auto mapping_result = validateDbusToMqttMapping(dbus_to_mqtt[i], i);
-        result.errors.insert(result.errors.end(), mapping_result.errors.begin(), mapping_result.errors.end());
-        result.warnings.insert(result.warnings.end(), mapping_result.warnings.begin(), mapping_result.warnings.end());
-        if (mapping_result.hasErrors()) result.valid = false;
-    }
+    validateEach(result, dbus_to_mqtt, threads, [this](const DbusToMqttMapping& m, size_t i) {
+        return validateDbusToMqttMapping(m, i);
+    });
+    
+    // Validate each properties_to_mqtt mapping
+    validateEach(result, properties_to_mqtt, threads, [this](const PropertiesToMqttMapping& m, size_t i) {
+        return validatePropertiesToMqttMapping(m, i);
+    });
     
     // Validate each mqtt_to_dbus mapping
-    for (size_t i = 0; i < mqtt_to_dbus.size(); ++i) {
-        auto mapping_result = validateMqttToDbusMapping(mqtt_to_dbus[i], i);
-        result.errors.insert(result.errors.end(), mapping_result.errors.begin(), mapping_result.errors.end());
-        result.warnings.insert(result.warnings.end(), mapping_result.warnings.begin(), mapping_result.warnings.end());
-        if (mapping_result.hasErrors()) result.valid = false;
-    }
+    validateEach(result, mqtt_to_dbus, threads, [this](const MqttToDbusMapping& m, size_t i) {
+        return validateMqttToDbusMapping(m, i);
+    });
     
     // Check for duplicate MQTT topics in subscriptions
-    std::vector<std::string> subscribe_topics;
+    std::unordered_set<std::string_view> subscribe_topics;
+    subscribe_topics.reserve(mqtt_to_dbus.size());
     for (const auto& mapping : mqtt_to_dbus) {
-        if (std::find(subscribe_topics.begin(), subscribe_topics.end(), mapping.topic) != subscribe_topics.end()) {
+        if (!subscribe_topics.insert(mapping.topic).second) {
             result.addError("mappings.mqtt_to_dbus", 
                 "Duplicate MQTT topic '" + mapping.topic + "' in mqtt_to_dbus mappings");
         }
-        subscribe_topics.push_back(mapping.topic);
     }
     
     return result;
@@ -151,18 +425,26 @@ ValidationResult Config::validateDbusToMqttMapping(const DbusToMqttMapping& mapp
     ValidationResult result;
     std::string prefix = "mappings.dbus_to_mqtt[" + std::to_string(index) + "]";
     
-    // Validate service name
-    if (!ConfigValidator::validateDbusServiceName(mapping.service)) {
+    // Validate service name (optional: omitted means any sender)
+    if (!mapping.service.empty() && !ConfigValidator::validateDbusServiceName(mapping.service)) {
         result.addError(prefix + ".service", 
             "Invalid D-Bus service name '" + mapping.service + 
             "'. Must follow reverse-DNS format (e.g., org.example.Service)");
     }
     
-    // Validate object path
-    if (!ConfigValidator::validateDbusObjectPath(mapping.path)) {
+    // Validate object path / path namespace (exactly one of them)
+    if (mapping.path.empty() == mapping.path_namespace.empty()) {
+        result.addError(prefix + ".path", 
+            "Exactly one of 'path' or 'path_namespace' must be set");
+    } else if (!mapping.path.empty() && !ConfigValidator::validateDbusObjectPath(mapping.path)) {
         result.addError(prefix + ".path", 
             "Invalid D-Bus object path '" + mapping.path + 
             "'. Must start with '/' and contain only [a-zA-Z0-9_/] (e.g., /org/example/Object)");
+    } else if (!mapping.path_namespace.empty() &&
+               !ConfigValidator::validateDbusObjectPath(mapping.path_namespace)) {
+        result.addError(prefix + ".path_namespace", 
+            "Invalid D-Bus path namespace '" + mapping.path_namespace + 
+            "'. Must be a valid object path (e.g., /org/freedesktop/systemd1/unit)");
     }
     
     // Validate interface name
@@ -172,20 +454,89 @@ ValidationResult Config::validateDbusToMqttMapping(const DbusToMqttMapping& mapp
             "'. Must follow reverse-DNS format (e.g., org.example.Interface)");
     }
     
-    // Validate signal name
-    if (!ConfigValidator::validateDbusMemberName(mapping.signal)) {
+    // Validate signal name (optional: omitted means every signal on the interface)
+    if (!mapping.signal.empty() && !ConfigValidator::validateDbusMemberName(mapping.signal)) {
         result.addError(prefix + ".signal", 
             "Invalid D-Bus signal name '" + mapping.signal + 
             "'. Must start with letter and contain only [a-zA-Z0-9_]");
     }
     
-    // Validate MQTT topic (no wildcards in publish topics)
-    if (!ConfigValidator::validateMqttTopic(mapping.topic, false)) {
-        result.addError(prefix + ".topic", 
-            "Invalid MQTT topic '" + mapping.topic + 
-            "'. Wildcards (+, #) are not allowed in publish topics");
+    validatePublishTopic(result, prefix + ".topic", mapping.topic);
+    
+    if (!ConfigValidator::validateQos(mapping.qos)) {
+        result.addError(prefix + ".qos", 
+            "Invalid QoS " + std::to_string(mapping.qos) + ". Must be 0, 1 or 2");
     }
     
+    validateOnChange(result, prefix, mapping.on_change, mapping.heartbeat);
+    
+    return result;
+}
+
+ValidationResult Config::validatePropertiesToMqttMapping(const PropertiesToMqttMapping& mapping, size_t index) const {
+    ValidationResult result;
+    std::string prefix = "mappings.properties_to_mqtt[" + std::to_string(index) + "]";
+    
+    // Validate service name (required: invalidated properties are fetched from it)
+    if (!ConfigValidator::validateDbusServiceName(mapping.service)) {
+        result.addError(prefix + ".service", 
+            "Invalid D-Bus service name '" + mapping.service + 
+            "'. Must follow reverse-DNS format (e.g., org.example.Service)");
+    }
+    
+    // Validate object path / path namespace (exactly one of them)
+    if (mapping.path.empty() == mapping.path_namespace.empty()) {
+        result.addError(prefix + ".path", 
+            "Exactly one of 'path' or 'path_namespace' must be set");
+    } else if (!mapping.path.empty() && !ConfigValidator::validateDbusObjectPath(mapping.path)) {
+        result.addError(prefix + ".path", 
+            "Invalid D-Bus object path '" + mapping.path + 
+            "'. Must start with '/' and contain only [a-zA-Z0-9_/] (e.g., /org/example/Object)");
+    } else if (!mapping.path_namespace.empty() &&
+               !ConfigValidator::validateDbusObjectPath(mapping.path_namespace)) {
+        result.addError(prefix + ".path_namespace", 
+            "Invalid D-Bus path namespace '" + mapping.path_namespace + 
+            "'. Must be a valid object path (e.g., /org/freedesktop/UPower/devices)");
+    }
+    
+    // Validate interface name (the interface whose properties are mirrored)
+    if (!ConfigValidator::validateDbusInterfaceName(mapping.interface)) {
+        result.addError(prefix + ".interface", 
+            "Invalid D-Bus interface name '" + mapping.interface + 
+            "'. Must follow reverse-DNS format (e.g., org.example.Interface)");
+    }
+    
+    validatePublishTopic(result, prefix + ".topic", mapping.topic);
+    
+    // A template replaces the "<topic>/<Property>" layout, so it must name
+    // the property itself (and the object, when several are mirrored);
+    // otherwise every property overwrites the same retained topic.
+    if (TopicTemplate::isTemplate(mapping.topic)) {
+        if (auto tpl = TopicTemplate::parse(mapping.topic)) {
+            auto uses = [&](TopicTemplate::Kind kind) {
+                return std::any_of(tpl->segments().begin(), tpl->segments().end(),
+                                   [kind](const auto& s) { return s.kind == kind; });
+            };
+            if (!uses(TopicTemplate::Kind::Property)) {
+                result.addError(prefix + ".topic", 
+                    "Topic template '" + mapping.topic + 
+                    "' must contain {property}, or all properties share one topic");
+            }
+            if (!mapping.path_namespace.empty() && !uses(TopicTemplate::Kind::Path)) {
+                result.addError(prefix + ".topic", 
+                    "Topic template '" + mapping.topic + 
+                    "' must contain {path} when 'path_namespace' is set, or all objects share one topic");
+            }
+        }
+    }
+    
+    if (!ConfigValidator::validateQos(mapping.qos)) {
+        result.addError(prefix + ".qos", 
+            "Invalid QoS " + std::to_string(mapping.qos) + ". Must be 0, 1 or 2");
+    }
+    
+    validateOnChange(result, prefix, mapping.on_change, mapping.heartbeat);
+    
     return result;
 }
 
@@ -227,11 +578,37 @@ ValidationResult Config::validateMqttToDbusMapping(const MqttToDbusMapping& mapp
             "'. Must follow reverse-DNS format");
     }
     
-    // Validate method name
-    if (!ConfigValidator::validateDbusMemberName(mapping.method)) {
-        result.addError(prefix + ".method", 
-            "Invalid D-Bus method name '" + mapping.method + 
-            "'. Must start with letter and contain only [a-zA-Z0-9_]");
+    // Validate action and the fields it needs
+    if (!ConfigValidator::validateMappingAction(mapping.action)) {
+        result.addError(prefix + ".action", 
+            "Invalid action '" + mapping.action + "'. Must be 'call', 'get' or 'set'");
+    } else if (mapping.action == "call") {
+        if (!ConfigValidator::validateDbusMemberName(mapping.method)) {
+            result.addError(prefix + ".method", 
+                "Invalid D-Bus method name '" + mapping.method + 
+                "'. Must start with letter and contain only [a-zA-Z0-9_]");
+        }
+    } else {
+        if (!ConfigValidator::validateDbusMemberName(mapping.property)) {
+            result.addError(prefix + ".property", 
+                "Invalid D-Bus property name '" + mapping.property + 
+                "'. Must start with letter and contain only [a-zA-Z0-9_]");
+        }
+        if (mapping.action == "get" && mapping.reply_topic.empty()) {
+            result.addError(prefix + ".reply_topic", 
+                "'reply_topic' is required for action 'get'");
+        }
+    }
+    
+    if (!ConfigValidator::validateQos(mapping.qos)) {
+        result.addError(prefix + ".qos", 
+            "Invalid QoS " + std::to_string(mapping.qos) + ". Must be 0, 1 or 2");
+    }
+    
+    if (!mapping.reply_topic.empty() && !ConfigValidator::validateMqttTopic(mapping.reply_topic, false)) {
+        result.addError(prefix + ".reply_topic", 
+            "Invalid MQTT topic '" + mapping.reply_topic + 
+            "'. Wildcards (+, #) are not allowed in publish topics");
     }
     
     return result;
@@ -0,0 +1,359 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2026 Ed Lee
+
+#include "ConfigCache.h"
+#include "StartupTimings.h"
+#include "Version.h"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <type_traits>
+#include <unordered_map>
+
+// Snapshot layout (native byte order; snapshots never leave the machine):
+//
+//   "DMBCACHE"  u32 format  u64 yaml-hash  str build-version  u64 checksum
+//   u32 count, count × str     interned string table
+//   body                        Config fields in fields() order
+//
+// where str is u32 length + bytes.  In the body a string is a u32 index into
+// the table, int is i32, bool is u8 and a sequence is u32 count + elements.
+// The checksum is the FNV-1a hash of everything after it.
+
+namespace {
+
+constexpr char     kMagic[8]      = {'D', 'M', 'B', 'C', 'A', 'C', 'H', 'E'};
+// Bump whenever fields() changes.  Snapshots of other builds are rejected
+// anyway through PROJECT_VERSION; this covers development builds.
+constexpr uint32_t kFormatVersion = 3;
+
+// Every persisted field, once, for both directions.  `ar` is a Writer
+// (with const objects) or a Reader.
+template <typename Ar, typename T>
+void fields(Ar& ar, T& v) {
+    using U = std::remove_const_t<T>;
+    if constexpr (std::is_same_v<U, MqttConfig>) {
+        ar(v.broker); ar(v.port); ar(v.username); ar(v.password);
+        ar(v.brokers); ar(v.failover);
+        ar(v.version); ar(v.message_expiry); ar(v.session_expiry); ar(v.topic_aliases);
+        ar(v.user_properties);
+        ar(v.max_inflight); ar(v.overflow_policy); ar(v.max_queued);
+        ar(v.connections); ar(v.optimize_subscriptions); ar(v.metrics_topic);
+    } else if constexpr (std::is_same_v<U, DbusToMqttMapping>) {
+        ar(v.service); ar(v.path); ar(v.path_namespace); ar(v.interface);
+        ar(v.signal); ar(v.topic); ar(v.qos); ar(v.retain); ar(v.on_change); ar(v.heartbeat);
+    } else if constexpr (std::is_same_v<U, PropertiesToMqttMapping>) {
+        ar(v.service); ar(v.path); ar(v.path_namespace); ar(v.interface);
+        ar(v.topic); ar(v.qos); ar(v.retain); ar(v.on_change); ar(v.heartbeat);
+    } else if constexpr (std::is_same_v<U, MqttToDbusMapping>) {
+        ar(v.topic); ar(v.service); ar(v.path); ar(v.interface); ar(v.action);
+        ar(v.method); ar(v.property); ar(v.reply_topic); ar(v.qos);
+    } else {
+        static_assert(std::is_same_v<U, Config>);
+        fields(ar, v.mqtt);
+        ar(v.bus_type); ar(v.event_loop); ar(v.watch_config);
+        ar(v.dbus_to_mqtt); ar(v.properties_to_mqtt); ar(v.mqtt_to_dbus);
+    }
+}
+
+class Writer {
+public:
+    void operator()(const std::string& s) {
+        auto [it, inserted] = index_.try_emplace(s, static_cast<uint32_t>(strings_.size()));
+        if (inserted) strings_.push_back(s);
+        put(body_, it->second);
+    }
+    void operator()(int v)  { put(body_, static_cast<int32_t>(v)); }
+    void operator()(bool v) { put(body_, static_cast<uint8_t>(v)); }
+    void operator()(const std::vector<std::string>& v) {
+        put(body_, static_cast<uint32_t>(v.size()));
+        for (const auto& s : v) (*this)(s);
+    }
+    void operator()(const std::map<std::string, std::string>& v) {
+        put(body_, static_cast<uint32_t>(v.size()));
+        for (const auto& [key, value] : v) { (*this)(key); (*this)(value); }
+    }
+    template <typename M>
+    void operator()(const std::vector<M>& v) {
+        put(body_, static_cast<uint32_t>(v.size()));
+        for (const auto& m : v) fields(*this, m);
+    }
+
+    std::string finish(uint64_t hash) const {
+        std::string out(kMagic, sizeof(kMagic));
+        put(out, kFormatVersion);
+        put(out, hash);
+        putString(out, PROJECT_VERSION);
+
+        std::string payload;
+        put(payload, static_cast<uint32_t>(strings_.size()));
+        for (auto s : strings_) putString(payload, s);
+        payload += body_;
+        put(out, ConfigCache::hash(payload));
+        return out + payload;
+    }
+
+private:
+    template <typename T>
+    static void put(std::string& out, T v) { out.append(reinterpret_cast<const char*>(&v), sizeof(v)); }
+    static void putString(std::string& out, std::string_view s) {
+        put(out, static_cast<uint32_t>(s.size()));
+        out.append(s);
+    }
+
+    std::string                                    body_;
+    std::vector<std::string_view>                  strings_;  // views into the encoded Config
+    std::unordered_map<std::string_view, uint32_t> index_;
+};
+
+// Bounds-checked counterpart of Writer.  Any inconsistency clears ok() and
+// turns the remaining reads into no-ops.
+class Reader {
+public:
+    Reader(std::string_view data, uint64_t hash) : data_(data) {
+        if (data_.size() < sizeof(kMagic) ||
+            std::memcmp(data_.data(), kMagic, sizeof(kMagic)) != 0) {
+            ok_ = false;
+            return;
+        }
+        pos_ = sizeof(kMagic);
+        if (get<uint32_t>() != kFormatVersion || get<uint64_t>() != hash ||
+            getString() != PROJECT_VERSION) {
+            ok_ = false;
+            return;
+        }
+        uint64_t checksum = get<uint64_t>();
+        if (!ok_ || ConfigCache::hash(data_.substr(pos_)) != checksum) {
+            ok_ = false;
+            return;
+        }
+        uint32_t n = count();
+        strings_.reserve(n);
+        for (uint32_t i = 0; i < n && ok_; ++i) strings_.push_back(getString());
+    }
+
+    bool ok() const { return ok_ && pos_ == data_.size(); }
+
+    void operator()(std::string& s) {
+        uint32_t i = get<uint32_t>();
+        if (i < strings_.size()) s = strings_[i];
+        else ok_ = false;
+    }
+    void operator()(int& v)  { v = get<int32_t>(); }
+    void operator()(bool& v) { v = get<uint8_t>() != 0; }
+    void operator()(std::vector<std::string>& v) {
+        v.resize(count());
+        for (auto& s : v) (*this)(s);
+    }
+    void operator()(std::map<std::string, std::string>& v) {
+        for (uint32_t n = count(); n > 0 && ok_; --n) {
+            std::string key, value;
+            (*this)(key);
+            (*this)(value);
+            v[std::move(key)] = std::move(value);
+        }
+    }
+    template <typename M>
+    void operator()(std::vector<M>& v) {
+        v.resize(count());
+        for (auto& m : v) fields(*this, m);
+    }
+
+private:
+    template <typename T>
+    T get() {
+        T v{};
+        if (!ok_ || data_.size() - pos_ < sizeof(T)) {
+            ok_ = false;
+            return v;
+        }
+        std::memcpy(&v, data_.data() + pos_, sizeof(T));
+        pos_ += sizeof(T);
+        return v;
+    }
+    std::string_view getString() {
+        uint32_t len = get<uint32_t>();
+        if (!ok_ || data_.size() - pos_ < len) {
+            ok_ = false;
+            return {};
+        }
+        auto s = data_.substr(pos_, len);
+        pos_ += len;
+        return s;
+    }
+    // Element counts are bounded by the bytes left (every element takes at
+    // least one), so corrupt data cannot trigger a huge allocation.
+    uint32_t count() {
+        uint32_t n = get<uint32_t>();
+        if (n > data_.size() - pos_) {
+            ok_ = false;
+            return 0;
+        }
+        return n;
+    }
+
+    std::string_view              data_;
+    size_t                        pos_ = 0;
+    bool                          ok_  = true;
+    std::vector<std::string_view> strings_;  // views into data_
+};
+
+void compileTemplate(const std::string& topic, TopicTemplate& compiled) {
+    if (!TopicTemplate::isTemplate(topic)) return;
+    if (auto tpl = TopicTemplate::parse(topic)) compiled = std::move(*tpl);
+}
+
+bool readFile(const std::string& path, std::string& out) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+    out.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    return !in.bad();
+}
+
+std::optional<Config> readSnapshot(const std::string& path, uint64_t hash,
+                                   ValidationResult& validation) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return std::nullopt;
+
+    std::optional<Config> config;
+    struct stat st;
+    if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+        void* data = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data != MAP_FAILED) {
+            config = ConfigCache::decode({static_cast<const char*>(data), static_cast<size_t>(st.st_size)},
+                                         hash, validation);
+            ::munmap(data, st.st_size);
+        }
+    }
+    ::close(fd);
+    return config;
+}
+
+// Written to a temporary file and renamed into place, so a concurrent start
+// sees either the old snapshot or the complete new one.
+void writeSnapshot(const std::string& path, const std::string& data) {
+    std::error_code ec;
+    std::filesystem::create_directories(std::filesystem::path(path).parent_path(), ec);
+
+    std::string tmp = path + ".tmp" + std::to_string(::getpid());
+    int fd = ::open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if (fd < 0) return;
+
+    size_t written = 0;
+    while (written < data.size()) {
+        ssize_t n = ::write(fd, data.data() + written, data.size() - written);
+        if (n <= 0) break;
+        written += static_cast<size_t>(n);
+    }
+    bool ok = ::close(fd) == 0 && written == data.size();
+    if (!ok || std::rename(tmp.c_str(), path.c_str()) != 0) ::unlink(tmp.c_str());
+}
+
+} // namespace
+
+Config ConfigCache::load(const std::string& path, ConfigFragments& fragments,
+                         ValidationResult& validation) {
+    using Phase = StartupTimings::Phase;
+    auto& timings = StartupTimings::instance();
+    auto start = StartupTimings::Clock::now();
+
+    std::string yaml;
+    bool readable = readFile(path, yaml);
+    Config config = readable ? Config() : Config::loadFromFile(path);  // throws the usual error
+
+    uint64_t parts[2] = {hash(yaml), fragments.scan()};
+    uint64_t key = hash({reinterpret_cast<const char*>(parts), sizeof(parts)});
+    std::string snapshot = readable ? snapshotPath(path) : "";
+    if (!snapshot.empty()) {
+        if (auto cached = readSnapshot(snapshot, key, validation)) {
+            timings.record(Phase::ConfigLoad, start);
+            timings.record(Phase::Validation, StartupTimings::Clock::duration::zero());
+            return std::move(*cached);
+        }
+    }
+
+    if (readable) config = Config::loadFromString(yaml);
+    timings.record(Phase::ConfigLoad, start);
+
+    start = StartupTimings::Clock::now();
+    validation = ValidationResult{};
+    fragments.merge(config, validation);
+    ValidationResult checked = config.validate();
+    validation.errors.insert(validation.errors.end(), checked.errors.begin(), checked.errors.end());
+    validation.warnings.insert(validation.warnings.end(), checked.warnings.begin(), checked.warnings.end());
+    if (checked.hasErrors()) validation.valid = false;
+    timings.record(Phase::Validation, start);
+
+    if (!snapshot.empty() && !validation.hasErrors()) {
+        writeSnapshot(snapshot, encode(config, validation, key));
+    }
+    return config;
+}
+
+std::string ConfigCache::encode(const Config& config, const ValidationResult& validation,
+                                uint64_t hash) {
+    Writer writer;
+    fields(writer, config);
+    writer(validation.warnings);
+    return writer.finish(hash);
+}
+
+std::optional<Config> ConfigCache::decode(std::string_view data, uint64_t hash,
+                                          ValidationResult& validation) {
+    Reader reader(data, hash);
+    Config config;
+    ValidationResult stored;
+    fields(reader, config);
+    reader(stored.warnings);
+    if (!reader.ok()) return std::nullopt;
+
+    // Compiled templates are not persisted; recompiling them is cheap.
+    for (auto& m : config.dbus_to_mqtt)       compileTemplate(m.topic, m.topic_template);
+    for (auto& m : config.properties_to_mqtt) compileTemplate(m.topic, m.topic_template);
+
+    validation = std::move(stored);
+    return config;
+}
+
+uint64_t ConfigCache::hash(std::string_view data) {
+    uint64_t h = 14695981039346656037ull;
+    for (unsigned char c : data) {
+        h ^= c;
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+std::string ConfigCache::directory() {
+    if (const char* dir = std::getenv("CACHE_DIRECTORY"); dir && *dir) {
+        // systemd passes a colon-separated list when several are configured
+        std::string first(dir);
+        return first.substr(0, first.find(':'));
+    }
+    if (const char* xdg = std::getenv("XDG_CACHE_HOME"); xdg && *xdg) {
+        return std::string(xdg) + "/dbus-mqtt-bridge";
+    }
+    if (const char* home = std::getenv("HOME"); home && *home) {
+        return std::string(home) + "/.cache/dbus-mqtt-bridge";
+    }
+    return "";
+}
+
+std::string ConfigCache::snapshotPath(const std::string& configPath) {
+    std::string dir = directory();
+    if (dir.empty()) return "";
+
+    std::error_code ec;
+    auto absolute = std::filesystem::absolute(configPath, ec);
+    char name[32];
+    std::snprintf(name, sizeof(name), "config-%016llx.bin",
+                  static_cast<unsigned long long>(hash(ec ? configPath : absolute.string())));
+    return dir + "/" + name;
+}
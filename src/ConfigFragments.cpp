@@ -0,0 +1,148 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2026 Ed Lee
+
+#include "ConfigFragments.h"
+#include "ConfigCache.h"
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iterator>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+bool readFile(const std::filesystem::path& path, std::string& out) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+    out.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    return !in.bad();
+}
+
+// Appends `mappings` to `into`, except those whose topic another file already
+// uses.  Duplicates within one file are left to validate().
+template <typename Mapping>
+void claim(const std::vector<Mapping>& mappings, std::vector<Mapping>& into,
+           std::unordered_map<std::string, std::string>& owners, const std::string& owner,
+           const char* section, ValidationResult& result) {
+    for (const auto& mapping : mappings) {
+        auto [it, inserted] = owners.try_emplace(mapping.topic, owner);
+        if (!inserted && it->second != owner) {
+            result.addError(owner, "MQTT topic '" + mapping.topic + "' in " + section +
+                                   " is already used by " + it->second);
+            continue;
+        }
+        into.push_back(mapping);
+    }
+}
+
+} // namespace
+
+ConfigFragments::ConfigFragments(std::string directory)
+    : directory_(std::move(directory)) {}
+
+std::string ConfigFragments::directoryFor(const std::string& configPath) {
+    return (std::filesystem::path(configPath).parent_path() / "conf.d").string();
+}
+
+uint64_t ConfigFragments::scan() {
+    std::map<std::string, Fragment> current;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(directory_, ec)) {
+        std::string name = entry.path().filename().string();
+        auto ext = entry.path().extension();
+        // Dot files are editor swap files and the like
+        if (name[0] == '.' || (ext != ".yaml" && ext != ".yml")) continue;
+        if (!entry.is_regular_file(ec)) continue;
+
+        auto mtime = entry.last_write_time(ec);
+        auto size  = entry.file_size(ec);
+        if (ec) continue;
+
+        auto old = fragments_.find(name);
+        if (old != fragments_.end() && old->second.mtime == mtime && old->second.size == size) {
+            current.emplace(name, std::move(old->second));
+            continue;
+        }
+
+        Fragment fragment;
+        fragment.mtime = mtime;
+        fragment.size  = size;
+        if (!readFile(entry.path(), fragment.yaml)) continue;
+        fragment.hash = ConfigCache::hash(fragment.yaml);
+        if (old != fragments_.end() && old->second.hash == fragment.hash) {
+            // Touched but unchanged: keep the parsed mappings
+            old->second.mtime = mtime;
+            current.emplace(name, std::move(old->second));
+        } else {
+            current.emplace(name, std::move(fragment));
+        }
+    }
+    fragments_ = std::move(current);
+    if (fragments_.empty()) return 0;
+
+    std::string digest;
+    for (const auto& [name, fragment] : fragments_) {
+        digest += name;
+        digest += '\0';
+        digest.append(reinterpret_cast<const char*>(&fragment.hash), sizeof(fragment.hash));
+    }
+    return ConfigCache::hash(digest);
+}
+
+void ConfigFragments::parseChanged() {
+    std::vector<Fragment*> pending;
+    for (auto& [name, fragment] : fragments_) {
+        if (!fragment.parsed) pending.push_back(&fragment);
+    }
+    if (pending.empty()) return;
+
+    // Fragments vary a lot in size, so workers pull the next one off a shared
+    // counter instead of taking fixed shares.
+    std::atomic<size_t> next{0};
+    auto work = [&] {
+        for (size_t i; (i = next++) < pending.size(); ) {
+            Fragment& fragment = *pending[i];
+            try {
+                fragment.mappings = Config::loadFragment(fragment.yaml);
+                fragment.error.clear();
+            } catch (const std::exception& e) {
+                fragment.mappings = Config{};
+                fragment.error = e.what();
+            }
+            fragment.yaml.clear();
+            fragment.yaml.shrink_to_fit();
+            fragment.parsed = true;
+        }
+    };
+
+    size_t threads = std::min<size_t>(pending.size(), std::max(1u, std::thread::hardware_concurrency()));
+    std::vector<std::thread> workers;
+    for (size_t t = 1; t < threads; ++t) workers.emplace_back(work);
+    work();
+    for (auto& worker : workers) worker.join();
+}
+
+void ConfigFragments::merge(Config& config, ValidationResult& result) {
+    parseChanged();
+
+    // mqtt_to_dbus topics are subscriptions and properties_to_mqtt topics
+    // hold retained state; two files sharing one would silently fight over it.
+    const std::string mainConfig = "the main config file";
+    std::unordered_map<std::string, std::string> subscribed, mirrored;
+    for (const auto& m : config.mqtt_to_dbus)       subscribed.try_emplace(m.topic, mainConfig);
+    for (const auto& m : config.properties_to_mqtt) mirrored.try_emplace(m.topic, mainConfig);
+
+    for (const auto& [name, fragment] : fragments_) {
+        std::string owner = "conf.d/" + name;
+        if (!fragment.error.empty()) {
+            result.addError(owner, fragment.error);
+            continue;
+        }
+        const Config& f = fragment.mappings;
+        config.dbus_to_mqtt.insert(config.dbus_to_mqtt.end(), f.dbus_to_mqtt.begin(), f.dbus_to_mqtt.end());
+        claim(f.properties_to_mqtt, config.properties_to_mqtt, mirrored, owner, "properties_to_mqtt", result);
+        claim(f.mqtt_to_dbus, config.mqtt_to_dbus, subscribed, owner, "mqtt_to_dbus", result);
+    }
+}
@@ -8,6 +8,7 @@
 #include "DbusIntrospector.h"
 #include <iostream>
 #include <algorithm>
+#include <chrono>
 
 bool ConfigGenerator::promptDbusService(std::string& result, const std::string& current, bool& system_bus) {
     while (true) {
@@ -122,6 +123,7 @@ bool ConfigGenerator::promptDbusPath(std::string& result, const std::string& ser
     while (true) {
         std::cout << "\nEnter D-Bus object path" << std::endl;
         std::cout << "  Press <Return> to browse, or enter full path directly" << std::endl;
+        std::cout << "  Or enter ?text to search all objects (e.g., ?ActiveState)" << std::endl;
         
         auto input_opt = InteractiveSelector::promptText("Path", current.empty() ? "" : current);
         if (!input_opt) {
@@ -130,6 +132,13 @@ bool ConfigGenerator::promptDbusPath(std::string& result, const std::string& ser
         
         std::string input = *input_opt;
         
+        if (!input.empty() && input[0] == '?') {
+            if (searchDbusPath(result, service, input.substr(1), system_bus)) {
+                return true;
+            }
+            continue;
+        }
+        
         // If user entered a direct path, validate and return
         if (!input.empty()) {
             if (ConfigValidator::validateDbusObjectPath(input)) {
@@ -227,6 +236,49 @@ bool ConfigGenerator::promptDbusPath(std::string& result, const std::string& ser
     }
 }
 
+bool ConfigGenerator::searchDbusPath(std::string& result, const std::string& service,
+                                     const std::string& query, bool system_bus) {
+    try {
+        std::cout << "Crawling " << service << "..." << std::endl;
+        auto started = std::chrono::steady_clock::now();
+        auto index = DbusIntrospector::crawl(service, system_bus);
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - started);
+        std::cout << "Indexed " << index.size() << " objects in " << elapsed.count() << " ms" << std::endl;
+        
+        auto hits = index.search(query);
+        if (hits.empty()) {
+            std::cout << "Nothing matches '" << query << "'" << std::endl;
+            return false;
+        }
+        
+        std::vector<std::string> items;
+        for (const auto& hit : hits) {
+            const char* kind = hit.kind == ObjectIndex::MemberKind::Method ? "method"
+                             : hit.kind == ObjectIndex::MemberKind::Signal ? "signal" : "property";
+            items.push_back(hit.path + "  " + hit.interface + "." + hit.member + " (" + kind + ")");
+        }
+        
+        auto selection = InteractiveSelector::selectFromList(
+            "Matches for '" + query + "' (" + std::to_string(hits.size()) + ")", items, false);
+        if (!selection) {
+            return false;
+        }
+        
+        auto pos = std::find(items.begin(), items.end(), *selection) - items.begin();
+        if (pos >= static_cast<long>(hits.size())) {
+            return false;
+        }
+        result = hits[pos].path;
+        std::cout << "Selected " << hits[pos].interface << "." << hits[pos].member
+                  << " on " << result << std::endl;
+        return true;
+    } catch (const std::exception& e) {
+        std::cout << "Error crawling " << service << ": " << e.what() << std::endl;
+        return false;
+    }
+}
+
 bool ConfigGenerator::promptDbusInterface(std::string& result, const std::string& service,
                                           const std::string& path,
                                           const std::string& current,
@@ -16,6 +16,33 @@ std::string ConfigGenerator::configToYaml(const Config& config) {
     oss << "mqtt:" << std::endl;
     oss << "  broker: " << config.mqtt.broker << std::endl;
     oss << "  port: " << config.mqtt.port << std::endl;
+    if (!config.mqtt.brokers.empty()) {
+        oss << "  brokers:" << std::endl;
+        for (const auto& entry : config.mqtt.brokers) {
+            oss << "    - \"" << entry << "\"" << std::endl;
+        }
+    }
+    if (config.mqtt.failover != "priority") oss << "  failover: " << config.mqtt.failover << std::endl;
+    
+    if (config.mqtt.max_inflight != 1000)       oss << "  max_inflight: " << config.mqtt.max_inflight << std::endl;
+    if (config.mqtt.overflow_policy != "queue") oss << "  overflow_policy: " << config.mqtt.overflow_policy << std::endl;
+    if (config.mqtt.max_queued != 10000)        oss << "  max_queued: " << config.mqtt.max_queued << std::endl;
+    if (config.mqtt.connections != 1)           oss << "  connections: " << config.mqtt.connections << std::endl;
+    if (config.mqtt.optimize_subscriptions)     oss << "  optimize_subscriptions: true" << std::endl;
+    if (!config.mqtt.metrics_topic.empty())     oss << "  metrics_topic: \"" << config.mqtt.metrics_topic << "\"" << std::endl;
+    
+    if (config.mqtt.version != 3) {
+        oss << "  version: " << config.mqtt.version << std::endl;
+        if (config.mqtt.message_expiry > 0) oss << "  message_expiry: " << config.mqtt.message_expiry << std::endl;
+        if (config.mqtt.session_expiry > 0) oss << "  session_expiry: " << config.mqtt.session_expiry << std::endl;
+        if (config.mqtt.topic_aliases != 16) oss << "  topic_aliases: " << config.mqtt.topic_aliases << std::endl;
+        if (!config.mqtt.user_properties.empty()) {
+            oss << "  user_properties:" << std::endl;
+            for (const auto& [name, value] : config.mqtt.user_properties) {
+                oss << "    " << name << ": " << value << std::endl;
+            }
+        }
+    }
     
     if (!config.mqtt.username.empty()) {
         oss << "  auth:" << std::endl;
@@ -25,6 +52,12 @@ std::string ConfigGenerator::configToYaml(const Config& config) {
     
     oss << std::endl;
     oss << "bus_type: " << config.bus_type << std::endl;
+    if (config.event_loop != "threaded") {
+        oss << "event_loop: " << config.event_loop << std::endl;
+    }
+    if (config.watch_config) {
+        oss << "watch_config: true" << std::endl;
+    }
     oss << std::endl;
     
     oss << "mappings:" << std::endl;
@@ -35,11 +68,40 @@ std::string ConfigGenerator::configToYaml(const Config& config) {
         oss << "    []" << std::endl;
     } else {
         for (const auto& m : config.dbus_to_mqtt) {
+            // Wildcard mappings may omit service/signal and use
+            // path_namespace; write only the fields that are set.
+            const char* lead = "    - ";
+            auto field = [&](const char* key, const std::string& value) {
+                if (value.empty()) return;
+                oss << lead << key << ": " << value << std::endl;
+                lead = "      ";
+            };
+            field("service", m.service);
+            field("path", m.path);
+            field("path_namespace", m.path_namespace);
+            field("interface", m.interface);
+            field("signal", m.signal);
+            field("topic", m.topic);
+            if (m.qos != 1) oss << "      qos: " << m.qos << std::endl;
+            if (m.retain)   oss << "      retain: true" << std::endl;
+            if (m.on_change)     oss << "      on_change: true" << std::endl;
+            if (m.heartbeat > 0) oss << "      heartbeat: " << m.heartbeat << std::endl;
+        }
+    }
+    
+    // Mirrored D-Bus properties (only written when used)
+    if (!config.properties_to_mqtt.empty()) {
+        oss << "  properties_to_mqtt:" << std::endl;
+        for (const auto& m : config.properties_to_mqtt) {
             oss << "    - service: " << m.service << std::endl;
-            oss << "      path: " << m.path << std::endl;
+            if (!m.path.empty())           oss << "      path: " << m.path << std::endl;
+            if (!m.path_namespace.empty()) oss << "      path_namespace: " << m.path_namespace << std::endl;
             oss << "      interface: " << m.interface << std::endl;
-            oss << "      signal: " << m.signal << std::endl;
             oss << "      topic: " << m.topic << std::endl;
+            if (m.qos != 1)  oss << "      qos: " << m.qos << std::endl;
+            if (!m.retain)   oss << "      retain: false" << std::endl;
+            if (m.on_change)     oss << "      on_change: true" << std::endl;
+            if (m.heartbeat > 0) oss << "      heartbeat: " << m.heartbeat << std::endl;
         }
     }
     
@@ -53,7 +115,11 @@ std::string ConfigGenerator::configToYaml(const Config& config) {
             oss << "      service: " << m.service << std::endl;
             oss << "      path: " << m.path << std::endl;
             oss << "      interface: " << m.interface << std::endl;
-            oss << "      method: " << m.method << std::endl;
+            if (m.action != "call") oss << "      action: " << m.action << std::endl;
+            if (!m.method.empty())      oss << "      method: " << m.method << std::endl;
+            if (!m.property.empty())    oss << "      property: " << m.property << std::endl;
+            if (!m.reply_topic.empty()) oss << "      reply_topic: " << m.reply_topic << std::endl;
+            if (m.qos != 1)             oss << "      qos: " << m.qos << std::endl;
         }
     }
     
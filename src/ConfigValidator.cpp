@@ -2,9 +2,43 @@
 // Copyright (C) 2026 Ed Lee
 
 #include "ConfigValidator.h"
-#include <regex>
 #include <iostream>
 #include <sstream>
+#include <string_view>
+
+// The validators below are hand-written scanners rather than std::regex:
+// they run once per field of every mapping, and a regex costs a compile
+// plus allocations per call, which dominated validating large configs.
+
+namespace {
+
+bool isAlpha(char c) { return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z'); }
+bool isDigit(char c) { return c >= '0' && c <= '9'; }
+bool isAlnum(char c) { return isAlpha(c) || isDigit(c); }
+
+// [a-zA-Z_][a-zA-Z0-9_]*
+bool isIdentifier(std::string_view s) {
+    if (s.empty() || !(isAlpha(s[0]) || s[0] == '_')) return false;
+    for (char c : s) {
+        if (!(isAlnum(c) || c == '_')) return false;
+    }
+    return true;
+}
+
+// Calls f(element) for each part of `s` between separators; stops early
+// and returns false as soon as f does.
+template <typename F>
+bool eachPart(std::string_view s, char sep, F f) {
+    size_t start = 0;
+    while (true) {
+        size_t end = s.find(sep, start);
+        if (!f(s.substr(start, end == std::string_view::npos ? end : end - start))) return false;
+        if (end == std::string_view::npos) return true;
+        start = end + 1;
+    }
+}
+
+} // namespace
 
 bool ConfigValidator::validateMqttBroker(const std::string& broker) {
     if (broker.empty()) return false;
@@ -38,9 +72,11 @@ bool ConfigValidator::validateMqttTopic(const std::string& topic, bool allow_wil
         if (topic.length() > 1 && topic[topic.length()-2] != '/') return false;
     }
     
-    // Valid characters check
-    std::regex valid_topic(R"(^[a-zA-Z0-9/_+#-]+$)");
-    return std::regex_match(topic, valid_topic);
+    // Valid characters check: [a-zA-Z0-9/_+#-]
+    for (char c : topic) {
+        if (!(isAlnum(c) || c == '/' || c == '_' || c == '+' || c == '#' || c == '-')) return false;
+    }
+    return true;
 }
 
 bool ConfigValidator::validateDbusServiceName(const std::string& service) {
@@ -53,8 +89,7 @@ bool ConfigValidator::validateDbusServiceName(const std::string& service) {
     if (service.find('.') == std::string::npos) return false;
     if (service.find("..") != std::string::npos) return false;
     
-    std::regex service_pattern(R"(^[a-zA-Z_][a-zA-Z0-9_]*(\.[a-zA-Z_][a-zA-Z0-9_]*)+$)");
-    return std::regex_match(service, service_pattern);
+    return eachPart(service, '.', isIdentifier);
 }
 
 bool ConfigValidator::validateDbusObjectPath(const std::string& path) {
@@ -70,8 +105,10 @@ bool ConfigValidator::validateDbusObjectPath(const std::string& path) {
     if (path.find("//") != std::string::npos) return false;
     
     // Each path element must contain only [a-zA-Z0-9_]
-    std::regex path_pattern(R"(^(/[a-zA-Z0-9_]+)+$)");
-    return std::regex_match(path, path_pattern);
+    for (char c : path) {
+        if (!(isAlnum(c) || c == '_' || c == '/')) return false;
+    }
+    return true;
 }
 
 bool ConfigValidator::validateDbusInterfaceName(const std::string& interface) {
@@ -83,14 +120,33 @@ bool ConfigValidator::validateDbusMemberName(const std::string& member) {
     if (member.empty()) return false;
     
     // Must start with letter, contain alphanumeric or underscore
-    std::regex member_pattern(R"(^[a-zA-Z_][a-zA-Z0-9_]*$)");
-    return std::regex_match(member, member_pattern);
+    return isIdentifier(member);
 }
 
 bool ConfigValidator::validateBusType(const std::string& bus_type) {
     return bus_type == "system" || bus_type == "session";
 }
 
+bool ConfigValidator::validateEventLoop(const std::string& event_loop) {
+    return event_loop == "threaded" || event_loop == "reactor";
+}
+
+bool ConfigValidator::validateMappingAction(const std::string& action) {
+    return action == "call" || action == "get" || action == "set";
+}
+
+bool ConfigValidator::validateQos(int qos) {
+    return qos >= 0 && qos <= 2;
+}
+
+bool ConfigValidator::validateOverflowPolicy(const std::string& policy) {
+    return policy == "queue" || policy == "conflate" || policy == "drop";
+}
+
+bool ConfigValidator::validateFailover(const std::string& failover) {
+    return failover == "priority" || failover == "round_robin";
+}
+
 bool ConfigValidator::isValidHostname(const std::string& hostname) {
     if (hostname.empty() || hostname.length() > 253) return false;
     
@@ -101,28 +157,33 @@ bool ConfigValidator::isValidHostname(const std::string& hostname) {
 }
 
 bool ConfigValidator::isValidIpAddress(const std::string& ip) {
-    // Simple IPv4 validation
-    std::regex ipv4_pattern(R"(^(\d{1,3}\.){3}\d{1,3}$)");
-    if (!std::regex_match(ip, ipv4_pattern)) return false;
-    
-    // Check each octet is 0-255
-    std::istringstream iss(ip);
-    std::string octet;
-    while (std::getline(iss, octet, '.')) {
-        int val = std::stoi(octet);
-        if (val < 0 || val > 255) return false;
-    }
-    
-    return true;
+    // Simple IPv4 validation: four dot-separated octets of 1-3 digits, 0-255
+    int octets = 0;
+    bool ok = eachPart(ip, '.', [&octets](std::string_view octet) {
+        if (++octets > 4 || octet.empty() || octet.size() > 3) return false;
+        int val = 0;
+        for (char c : octet) {
+            if (!isDigit(c)) return false;
+            val = val * 10 + (c - '0');
+        }
+        return val <= 255;
+    });
+    return ok && octets == 4;
 }
 
 bool ConfigValidator::isValidDnsName(const std::string& name) {
     if (name.empty() || name.length() > 253) return false;
     
     // DNS name: labels separated by dots
-    // Each label: 1-63 chars, start with letter/digit, contain letter/digit/hyphen
-    std::regex dns_pattern(R"(^[a-zA-Z0-9]([a-zA-Z0-9-]{0,61}[a-zA-Z0-9])?(\.[a-zA-Z0-9]([a-zA-Z0-9-]{0,61}[a-zA-Z0-9])?)*$)");
-    return std::regex_match(name, dns_pattern);
+    // Each label: 1-63 chars, start and end with letter/digit, contain letter/digit/hyphen
+    return eachPart(name, '.', [](std::string_view label) {
+        if (label.empty() || label.size() > 63) return false;
+        if (!isAlnum(label.front()) || !isAlnum(label.back())) return false;
+        for (char c : label) {
+            if (!(isAlnum(c) || c == '-')) return false;
+        }
+        return true;
+    });
 }
 
 std::string ConfigValidator::formatValidationErrors(const ValidationResult& result) {
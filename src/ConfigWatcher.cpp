@@ -0,0 +1,99 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2026 Ed Lee
+
+#include "ConfigWatcher.h"
+#include <sys/inotify.h>
+#include <poll.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <string_view>
+#include <stdexcept>
+
+namespace {
+
+bool isFragment(const char* name) {
+    std::string_view n(name);
+    if (n.empty() || n[0] == '.') return false;
+    return n.ends_with(".yaml") || n.ends_with(".yml");
+}
+
+} // namespace
+
+ConfigWatcher::ConfigWatcher(const std::string& path, const std::string& fragmentDir) {
+    std::filesystem::path p = std::filesystem::absolute(path);
+    fileName_ = p.filename().string();
+
+    fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd_ < 0) {
+        throw std::runtime_error(std::string("inotify_init1: ") + std::strerror(errno));
+    }
+
+    // IN_CLOSE_WRITE: edited in place.  IN_MOVED_TO/IN_CREATE: replaced by
+    // rename, as most editors and configuration management tools do.
+    std::string dir = p.parent_path().string();
+    if (inotify_add_watch(fd_, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE) < 0) {
+        int err = errno;
+        ::close(fd_);
+        throw std::runtime_error("inotify_add_watch(" + dir + "): " + std::strerror(err));
+    }
+
+    if (!fragmentDir.empty()) {
+        std::filesystem::path f = std::filesystem::absolute(fragmentDir);
+        fragmentDir_ = f.string();
+        if (f.parent_path() == p.parent_path()) fragmentDirName_ = f.filename().string();
+        watchFragments();
+    }
+}
+
+// Fails quietly while the directory does not exist; the config directory
+// watch reports its creation (when it lives there) and we retry then.
+void ConfigWatcher::watchFragments() {
+    fragmentWatch_ = inotify_add_watch(fd_, fragmentDir_.c_str(),
+                                       IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE |
+                                       IN_DELETE | IN_MOVED_FROM | IN_ONLYDIR);
+}
+
+ConfigWatcher::~ConfigWatcher() {
+    if (fd_ >= 0) ::close(fd_);
+}
+
+bool ConfigWatcher::consumeEvents() {
+    alignas(inotify_event) char buffer[4096];
+    bool changed = false;
+
+    while (true) {
+        ssize_t len = ::read(fd_, buffer, sizeof(buffer));
+        if (len <= 0) break;
+
+        for (char* ptr = buffer; ptr < buffer + len; ) {
+            auto* event = reinterpret_cast<inotify_event*>(ptr);
+            if (event->len == 0) {
+                // IN_IGNORED etc.: the fragment directory went away
+                if (event->wd == fragmentWatch_ && (event->mask & IN_IGNORED)) {
+                    fragmentWatch_ = -1;
+                    changed = true;
+                }
+            } else if (event->wd == fragmentWatch_) {
+                if (isFragment(event->name)) changed = true;
+            } else if (fileName_ == event->name) {
+                changed = true;
+            } else if (fragmentWatch_ < 0 && !fragmentDirName_.empty() &&
+                       fragmentDirName_ == event->name) {
+                watchFragments();
+                changed = true;
+            }
+            ptr += sizeof(inotify_event) + event->len;
+        }
+    }
+    return changed;
+}
+
+bool ConfigWatcher::waitForChange(std::chrono::milliseconds timeout) {
+    pollfd pfd{fd_, POLLIN, 0};
+    if (::poll(&pfd, 1, static_cast<int>(timeout.count())) <= 0) {
+        return false;
+    }
+    return consumeEvents();
+}
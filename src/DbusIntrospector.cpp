@@ -3,9 +3,59 @@
 
 #include "DbusIntrospector.h"
 #include <sdbus-c++/sdbus-c++.h>
-#include <regex>
 #include <algorithm>
 #include <iostream>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <deque>
+#include <poll.h>
+
+struct DbusIntrospector::BusState {
+    std::unique_ptr<sdbus::IConnection> connection;
+    std::unique_ptr<sdbus::IProxy>      busProxy;   // org.freedesktop.DBus
+    std::optional<std::vector<std::string>> names;  // sorted well-known names
+    std::map<std::pair<std::string, std::string>, DbusObject> objects;  // (service, path)
+
+    explicit BusState(bool system_bus)
+        : connection(system_bus ? sdbus::createSystemBusConnection()
+                                : sdbus::createSessionBusConnection())
+    {
+        busProxy = sdbus::createProxy(*connection, "org.freedesktop.DBus", "/org/freedesktop/DBus");
+        busProxy->registerSignalHandler(
+            "org.freedesktop.DBus",
+            "NameOwnerChanged",
+            [this](sdbus::Signal& signal) {
+                std::string name, old_owner, new_owner;
+                signal >> name >> old_owner >> new_owner;
+                onNameOwnerChanged(name);
+            });
+        busProxy->finishRegistration();
+    }
+
+    void onNameOwnerChanged(const std::string& name) {
+        if (!name.empty() && name[0] != ':') names.reset();
+        for (auto it = objects.begin(); it != objects.end();) {
+            it = (it->first.first == name) ? objects.erase(it) : std::next(it);
+        }
+    }
+
+    // There is no event loop: signals queued up while we were in a method
+    // call are dispatched here, before the caches are consulted.
+    void processPending() {
+        while (connection->processPendingRequest()) {}
+    }
+};
+
+DbusIntrospector::BusState& DbusIntrospector::bus(bool system_bus) {
+    // A failed connect is not remembered, so a bus that comes up later
+    // still gets used.
+    static std::unique_ptr<BusState> system, session;
+    auto& state = system_bus ? system : session;
+    if (!state) state = std::make_unique<BusState>(system_bus);
+    state->processPending();
+    return *state;
+}
 
 BusServices DbusIntrospector::listAllServices() {
     BusServices services;
@@ -26,14 +76,11 @@ BusServices DbusIntrospector::listAllServices() {
 }
 
 std::vector<std::string> DbusIntrospector::listServices(bool system_bus) {
-    auto connection = system_bus ? 
-        sdbus::createSystemBusConnection() : 
-        sdbus::createSessionBusConnection();
-    
-    auto proxy = sdbus::createProxy(*connection, "org.freedesktop.DBus", "/org/freedesktop/DBus");
+    auto& state = bus(system_bus);
+    if (state.names) return *state.names;
     
     std::vector<std::string> names;
-    proxy->callMethod("ListNames")
+    state.busProxy->callMethod("ListNames")
          .onInterface("org.freedesktop.DBus")
          .storeResultsTo(names);
     
@@ -46,66 +93,135 @@ std::vector<std::string> DbusIntrospector::listServices(bool system_bus) {
     }
     
     std::sort(filtered.begin(), filtered.end());
+    state.names = filtered;
     return filtered;
 }
 
-IntrospectionData DbusIntrospector::introspect(
+DbusObject DbusIntrospector::introspectObject(
     const std::string& service,
     const std::string& path,
     bool system_bus
 ) {
-    std::string xml = callIntrospect(service, path, system_bus);
-    return parseIntrospectionXml(xml);
+    return object(service, path, system_bus);
 }
 
-std::vector<std::string> DbusIntrospector::getSignalsForInterface(
+ObjectIndex DbusIntrospector::crawl(
     const std::string& service,
-    const std::string& path,
-    const std::string& interface,
-    bool system_bus
+    bool system_bus,
+    size_t max_in_flight
 ) {
-    std::string xml = callIntrospect(service, path, system_bus);
+    auto& state = bus(system_bus);
+    ObjectIndex index;
+    size_t failures = 0;
     
-    // Extract signals for specific interface
-    std::vector<std::string> signals;
-    std::regex interface_regex("<interface name=\"" + interface + "\">(.*?)</interface>", 
-                               std::regex::extended);
-    std::smatch interface_match;
+    std::deque<std::string> queue{"/"};
+    std::map<std::string, std::unique_ptr<sdbus::IProxy>> in_flight;
+    // Proxies whose reply has been handled; destroyed outside their callback
+    std::vector<std::unique_ptr<sdbus::IProxy>> retired;
     
-    if (std::regex_search(xml, interface_match, interface_regex)) {
-        std::string interface_xml = interface_match[1];
-        signals = extractElements(interface_xml, "signal", "name");
+    auto visit = [&](const std::string& path, const DbusObject& obj) {
+        for (const auto& child : obj.children) {
+            queue.push_back(path == "/" ? "/" + child : path + "/" + child);
+        }
+        index.add(path, obj);
+    };
+    
+    while (!queue.empty() || !in_flight.empty()) {
+        while (!queue.empty() && in_flight.size() < max_in_flight) {
+            std::string path = std::move(queue.front());
+            queue.pop_front();
+            
+            auto cached = state.objects.find({service, path});
+            if (cached != state.objects.end()) {
+                visit(path, cached->second);
+                continue;
+            }
+            
+            auto proxy = sdbus::createProxy(*state.connection, service, path);
+            proxy->callMethodAsync("Introspect")
+                 .onInterface("org.freedesktop.DBus.Introspectable")
+                 .uponReplyInvoke([&, path](const sdbus::Error* error, std::string xml) {
+                     auto it = in_flight.find(path);
+                     retired.push_back(std::move(it->second));
+                     in_flight.erase(it);
+                     if (error) {
+                         ++failures;
+                         return;
+                     }
+                     try {
+                         auto& obj = state.objects.insert_or_assign({service, path},
+                                                                    IntrospectionXml::parse(xml)).first->second;
+                         visit(path, obj);
+                     } catch (const std::exception&) {
+                         ++failures;
+                     }
+                 });
+            in_flight.emplace(path, std::move(proxy));
+        }
+        
+        // Dispatch whatever replies have arrived; otherwise wait for more.
+        if (!state.connection->processPendingRequest() && !in_flight.empty()) {
+            auto poll_data = state.connection->getEventLoopPollData();
+            pollfd pfd{poll_data.fd, poll_data.events, 0};
+            ::poll(&pfd, 1, poll_data.getPollTimeout());
+        }
+        retired.clear();
     }
     
-    return signals;
+    if (failures > 0) {
+        std::cerr << "Warning: " << failures << " object(s) of " << service
+                  << " could not be introspected" << std::endl;
+    }
+    return index;
 }
 
-std::vector<std::string> DbusIntrospector::getMethodsForInterface(
+IntrospectionData DbusIntrospector::introspect(
     const std::string& service,
     const std::string& path,
-    const std::string& interface,
     bool system_bus
 ) {
-    std::string xml = callIntrospect(service, path, system_bus);
+    const DbusObject& obj = object(service, path, system_bus);
     
-    // Extract methods for specific interface
-    std::vector<std::string> methods;
-    std::regex interface_regex("<interface name=\"" + interface + "\">(.*?)</interface>",
-                               std::regex::extended);
-    std::smatch interface_match;
-    
-    if (std::regex_search(xml, interface_match, interface_regex)) {
-        std::string interface_xml = interface_match[1];
-        methods = extractElements(interface_xml, "method", "name");
+    IntrospectionData data;
+    for (const auto& iface : obj.interfaces) {
+        data.interfaces.push_back(iface.name);
+        for (const auto& m : iface.signals) data.signals.push_back(m.name);
+        for (const auto& m : iface.methods) data.methods.push_back(m.name);
     }
+    data.child_paths = obj.children;
     
-    return methods;
+    // Sorted and free of duplicates, as the prompts list them
+    for (auto* list : {&data.interfaces, &data.signals, &data.methods, &data.child_paths}) {
+        std::sort(list->begin(), list->end());
+        list->erase(std::unique(list->begin(), list->end()), list->end());
+    }
+    return data;
+}
+
+std::vector<std::string> DbusIntrospector::getSignalsForInterface(
+    const std::string& service,
+    const std::string& path,
+    const std::string& interface,
+    bool system_bus
+) {
+    const DbusInterface* iface = object(service, path, system_bus).findInterface(interface);
+    return iface ? memberNames(iface->signals) : std::vector<std::string>{};
+}
+
+std::vector<std::string> DbusIntrospector::getMethodsForInterface(
+    const std::string& service,
+    const std::string& path,
+    const std::string& interface,
+    bool system_bus
+) {
+    const DbusInterface* iface = object(service, path, system_bus).findInterface(interface);
+    return iface ? memberNames(iface->methods) : std::vector<std::string>{};
 }
 
 bool DbusIntrospector::isSystemBusService(const std::string& service) {
     try {
         auto services = listServices(true);
-        return std::find(services.begin(), services.end(), service) != services.end();
+        return std::binary_search(services.begin(), services.end(), service);
     } catch (...) {
         return false;
     }
@@ -114,71 +230,37 @@ bool DbusIntrospector::isSystemBusService(const std::string& service) {
 bool DbusIntrospector::isSessionBusService(const std::string& service) {
     try {
         auto services = listServices(false);
-        return std::find(services.begin(), services.end(), service) != services.end();
+        return std::binary_search(services.begin(), services.end(), service);
     } catch (...) {
         return false;
     }
 }
 
-std::string DbusIntrospector::callIntrospect(
+const DbusObject& DbusIntrospector::object(
     const std::string& service,
     const std::string& path,
     bool system_bus
 ) {
-    auto connection = system_bus ? 
-        sdbus::createSystemBusConnection() : 
-        sdbus::createSessionBusConnection();
+    auto& state = bus(system_bus);
+    auto key = std::make_pair(service, path);
+    auto it = state.objects.find(key);
+    if (it != state.objects.end()) return it->second;
     
-    auto proxy = sdbus::createProxy(*connection, service, path);
+    auto proxy = sdbus::createProxy(*state.connection, service, path);
     
     std::string xml;
     proxy->callMethod("Introspect")
          .onInterface("org.freedesktop.DBus.Introspectable")
          .storeResultsTo(xml);
     
-    return xml;
-}
-
-IntrospectionData DbusIntrospector::parseIntrospectionXml(const std::string& xml) {
-    IntrospectionData data;
-    
-    // Extract interfaces
-    data.interfaces = extractElements(xml, "interface", "name");
-    
-    // Extract signals (from all interfaces)
-    data.signals = extractElements(xml, "signal", "name");
-    
-    // Extract methods (from all interfaces)
-    data.methods = extractElements(xml, "method", "name");
-    
-    // Extract child nodes/paths
-    data.child_paths = extractElements(xml, "node", "name");
-    
-    return data;
+    return state.objects.emplace(std::move(key), IntrospectionXml::parse(xml)).first->second;
 }
 
-std::vector<std::string> DbusIntrospector::extractElements(
-    const std::string& xml,
-    const std::string& element_name,
-    const std::string& name_attr
-) {
-    std::vector<std::string> results;
-    
-    // Pattern: <element_name name="value"
-    std::string pattern = "<" + element_name + "\\s+" + name_attr + "=\"([^\"]+)\"";
-    std::regex element_regex(pattern);
-    
-    auto words_begin = std::sregex_iterator(xml.begin(), xml.end(), element_regex);
-    auto words_end = std::sregex_iterator();
-    
-    for (std::sregex_iterator i = words_begin; i != words_end; ++i) {
-        std::smatch match = *i;
-        results.push_back(match[1]);
-    }
-    
-    // Remove duplicates and sort
-    std::sort(results.begin(), results.end());
-    results.erase(std::unique(results.begin(), results.end()), results.end());
-    
-    return results;
+std::vector<std::string> DbusIntrospector::memberNames(const std::vector<DbusMember>& members) {
+    std::vector<std::string> names;
+    names.reserve(members.size());
+    for (const auto& m : members) names.push_back(m.name);
+    std::sort(names.begin(), names.end());
+    names.erase(std::unique(names.begin(), names.end()), names.end());
+    return names;
 }
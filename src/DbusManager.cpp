@@ -2,23 +2,47 @@
 // Copyright (C) 2026 Ed Lee
 
 #include "DbusManager.h"
+#include "Reactor.h"
 #include "TypeUtils.h"
+#include "StartupTimings.h"
 #include <iostream>
 
+namespace {
+constexpr const char* kPropertiesInterface = "org.freedesktop.DBus.Properties";
+
+// True if `path` is the mapping's object or lies in its path namespace.
+bool covers(const PropertiesToMqttMapping& m, const std::string& path) {
+    if (!m.path.empty()) return m.path == path;
+    const std::string& ns = m.path_namespace;
+    return ns == "/" || path == ns ||
+           (path.size() > ns.size() && path.compare(0, ns.size(), ns) == 0 && path[ns.size()] == '/');
+}
+}
+
 DbusManager::DbusManager(const std::vector<DbusToMqttMapping>& signalMappings,
-                         const std::string& busType)
-    : mappings_(signalMappings)
-    , busType_(busType)
+                         const std::vector<PropertiesToMqttMapping>& propertyMappings,
+                         const std::string& busType,
+                         Reactor* reactor)
+    : busType_(busType)
+    , reactor_(reactor)
+    , mappings_(signalMappings)
+    , propertyMappings_(propertyMappings)
 {
+    auto start = StartupTimings::Clock::now();
     connection_ = (busType == "system")
         ? sdbus::createSystemBusConnection()
         : sdbus::createSessionBusConnection();
+    StartupTimings::instance().record(StartupTimings::Phase::DbusConnect, start);
 }
 
 void DbusManager::setSignalCallback(SignalCallback cb) {
     signalCallback_ = std::move(cb);
 }
 
+void DbusManager::setPropertyCallback(PropertyCallback cb) {
+    propertyCallback_ = std::move(cb);
+}
+
 // ── start ─────────────────────────────────────────────────────────────────────
 
 void DbusManager::start() {
@@ -28,14 +52,16 @@ void DbusManager::start() {
     // it disappears.
     watchServiceAppearance();
 
-    // Register signal handlers for every mapping.  In sdbus-c++, creating a
-    // proxy and registering a signal handler does NOT require the remote
-    // service to be running — the proxy is local.  We therefore attempt
-    // registration for every mapping unconditionally at startup.
+    // Install a match rule for every mapping.  Match rules do NOT require the
+    // remote service to be running, so every mapping is activated
+    // unconditionally at startup.
     //
-    // For each mapping we also check right now whether the service is already
-    // present on the bus and update activeServices_ accordingly, so that
-    // method calls via callMethod() are correctly gated from the start.
+    // Before that we check which services are already present on the bus and
+    // update activeServices_ accordingly, so that method calls via
+    // callMethod() are correctly gated from the start.
+    using Phase = StartupTimings::Phase;
+    auto& timings = StartupTimings::instance();
+    auto start = StartupTimings::Clock::now();
     {
         // Query currently active names once.
         std::vector<std::string> currentNames;
@@ -57,13 +83,94 @@ void DbusManager::start() {
             }
         }
     }
+    timings.record(Phase::ListNames, start);
 
-    for (const auto& mapping : mappings_) {
+    std::vector<DbusToMqttMapping> mappings;
+    std::vector<PropertiesToMqttMapping> propertyMappings;
+    {
+        std::lock_guard<std::mutex> lock(proxiesMutex_);
+        mappings = mappings_;
+        propertyMappings = propertyMappings_;
+    }
+    // AddMatch calls are sent back to back without waiting, so activating
+    // any number of mappings costs about one round trip.  start() holds one
+    // extra count until everything is sent; the last reply to come in (or
+    // the release below, if the replies were faster) reports completion.
+    activationStart_ = StartupTimings::Clock::now();
+    startupMatches_  = mappings.size() + propertyMappings.size();
+    pendingMatches_  = 1;
+    for (const auto& mapping : mappings) {
         activateMapping(mapping);
     }
+    for (const auto& mapping : propertyMappings) {
+        activatePropertyMapping(mapping);
+    }
 
     started_ = true;
-    connection_->enterEventLoopAsync();
+    if (reactor_) {
+        attachToReactor();
+    } else {
+        connection_->enterEventLoopAsync();
+    }
+    matchInstalled();
+}
+
+// ── asynchronous match rules ──────────────────────────────────────────────────
+
+sdbus::Slot DbusManager::addMatchAsync(const std::string& rule, sdbus::message_handler handler,
+                                       std::function<void()> installed) {
+    // Only rules sent by start() count towards startup completion; rules
+    // added later by reloads are just as asynchronous but not tracked.
+    const bool tracked = !started_;
+    if (tracked) ++pendingMatches_;
+    try {
+        // sdbus-c++ does not expose whether the AddMatch reply was an error,
+        // so any reply counts as the daemon having processed the rule.
+        return connection_->addMatchAsync(rule, std::move(handler),
+            [this, tracked, installed = std::move(installed)](sdbus::Message& /*reply*/) {
+                if (installed) installed();
+                if (tracked) matchInstalled();
+            });
+    } catch (...) {
+        if (tracked) matchInstalled();
+        throw;
+    }
+}
+
+void DbusManager::matchInstalled() {
+    if (--pendingMatches_ > 0) return;
+
+    auto elapsed = StartupTimings::Clock::now() - activationStart_;
+    StartupTimings::instance().record(StartupTimings::Phase::MappingActivation, elapsed);
+    std::cout << "DbusManager: " << startupMatches_ << " match rules confirmed in "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count()
+              << " ms" << std::endl;
+}
+
+// ── reactor integration ───────────────────────────────────────────────────────
+
+void DbusManager::attachToReactor() {
+    // sd-bus reports the events it wants as poll(2) flags; POLLIN/POLLOUT
+    // share their values with EPOLLIN/EPOLLOUT on Linux.
+    auto pollData = connection_->getEventLoopPollData();
+    busFd_ = pollData.fd;
+    reactor_->addFd(busFd_, static_cast<uint32_t>(pollData.events),
+                    [this] { processPendingRequests(); });
+
+    // Before every wait: dispatch anything sd-bus has already read into its
+    // queue (e.g. during a synchronous call made from another thread), since
+    // that would never make the fd readable again, then refresh the event
+    // mask and sd-bus's next internal timeout.
+    reactor_->addPrepareHook([this] {
+        processPendingRequests();
+        auto pollData = connection_->getEventLoopPollData();
+        reactor_->modifyFd(busFd_, static_cast<uint32_t>(pollData.events));
+        return pollData.getPollTimeout();
+    });
+}
+
+void DbusManager::processPendingRequests() {
+    while (connection_->processPendingRequest()) {}
 }
 
 // ── watchServiceAppearance ────────────────────────────────────────────────────
@@ -103,103 +210,508 @@ void DbusManager::onNameOwnerChanged(const std::string& name,
     if (appeared) {
         std::cout << "DbusManager: service appeared: " << name << std::endl;
 
-        // Mark the service active and activate any of its mappings whose
-        // proxies were registered but not yet live.
+        // Signal match rules are kept by the daemon across service restarts
+        // and never need re-registering; just mark the service active.
+        std::vector<PropertiesToMqttMapping> propertyMappings;
         {
             std::lock_guard<std::mutex> lock(proxiesMutex_);
             activeServices_.insert(name);
+            propertyMappings = propertyMappings_;
         }
-
-        // Re-register the signal handlers for any mapping on this service.
-        // The existing proxy object is still valid; calling finishRegistration
-        // again on a fresh proxy re-establishes the match rule with the daemon.
-        for (const auto& mapping : mappings_) {
-            if (mapping.service == name) {
-                std::cout << "DbusManager: activating mapping "
-                          << mapping.service << " " << mapping.path
-                          << " " << mapping.signal << std::endl;
-                activateMapping(mapping);
-            }
+        // Property match rules survive the restart too, but the new instance
+        // may start from different values: take a fresh snapshot.
+        for (const auto& mapping : propertyMappings) {
+            if (mapping.service == name) snapshotProperties(mapping);
         }
     } else if (disappeared) {
         std::cout << "DbusManager: service disappeared: " << name << std::endl;
 
         std::lock_guard<std::mutex> lock(proxiesMutex_);
         activeServices_.erase(name);
-        // The proxy objects remain in proxies_ — their signal handlers will
-        // simply not fire while the service is absent, and they will start
-        // receiving signals again automatically once the service reappears
-        // and we call activateMapping for them above.
+        // Cached values describe the old instance; drop them so nothing
+        // stale is served while the service is gone.
+        propertyCache_.dropService(name);
+        // The match rules stay installed — they simply do not fire while the
+        // service is absent and match again once it reappears.
     }
 }
 
-// ── activateMapping ───────────────────────────────────────────────────────────
+// ── signal mappings ───────────────────────────────────────────────────────────
+
+std::string DbusManager::buildMatchRule(const DbusToMqttMapping& mapping) {
+    // Names and paths were validated at config load and cannot contain
+    // quotes, so no escaping is needed.
+    std::string rule = "type='signal'";
+    if (!mapping.service.empty()) rule += ",sender='" + mapping.service + "'";
+    rule += ",interface='" + mapping.interface + "'";
+    if (!mapping.signal.empty()) rule += ",member='" + mapping.signal + "'";
+    if (!mapping.path_namespace.empty()) {
+        rule += ",path_namespace='" + mapping.path_namespace + "'";
+    } else {
+        rule += ",path='" + mapping.path + "'";
+    }
+    return rule;
+}
 
 void DbusManager::activateMapping(const DbusToMqttMapping& mapping) {
+    const std::string rule = buildMatchRule(mapping);
+    try {
+        auto slot = addMatchAsync(rule, [this, mapping](sdbus::Message& message) {
+            dispatchSignal(mapping, message);
+        });
+
+        // Replacing an existing entry destroys the previous slot, so
+        // re-activation never ends up with duplicate handlers.
+        sdbus::Slot previous;
+        std::lock_guard<std::mutex> lock(proxiesMutex_);
+        auto& entry = matchSlots_[mapping];
+        previous = std::move(entry);
+        entry = std::move(slot);
+    } catch (const std::exception& e) {
+        std::cerr << "DbusManager: failed to add match rule " << rule
+                  << ": " << e.what() << std::endl;
+    }
+}
+
+void DbusManager::dispatchSignal(const DbusToMqttMapping& mapping, sdbus::Message& message) {
+    if (!signalCallback_) return;
+
+    SignalSource source{message.getSender(), message.getPath(),
+                        message.getInterfaceName(), message.getMemberName()};
+    auto args = TypeUtils::unpackSignal(message);
+    signalCallback_(mapping, source, args);
+}
+
+// ── property mappings ─────────────────────────────────────────────────────────
+
+std::string DbusManager::buildPropertiesMatchRule(const PropertiesToMqttMapping& mapping) {
+    std::string rule = "type='signal',sender='" + mapping.service + "'";
+    rule += ",interface='" + std::string(kPropertiesInterface) + "',member='PropertiesChanged'";
+    if (!mapping.path_namespace.empty()) {
+        rule += ",path_namespace='" + mapping.path_namespace + "'";
+    } else {
+        rule += ",path='" + mapping.path + "'";
+    }
+    // arg0 is the interface whose properties changed; filtering here keeps
+    // other interfaces on the same objects off the connection entirely.
+    rule += ",arg0='" + mapping.interface + "'";
+    return rule;
+}
+
+void DbusManager::activatePropertyMapping(const PropertiesToMqttMapping& mapping) {
+    const std::string rule = buildPropertiesMatchRule(mapping);
     try {
-        auto proxy = sdbus::createProxy(*connection_, mapping.service, mapping.path);
-
-        proxy->registerSignalHandler(
-            mapping.interface,
-            mapping.signal,
-            [this, mapping](sdbus::Signal& signal) {
-                auto args = TypeUtils::unpackSignal(signal);
-                if (signalCallback_) {
-                    signalCallback_(mapping, args);
+        // Snapshot only once the daemon has confirmed the match rule so no
+        // change can fall between the two.  Absent services are snapshotted
+        // when they appear; calling them now would only trigger D-Bus
+        // activation.
+        auto slot = addMatchAsync(rule,
+            [this, mapping](sdbus::Message& message) {
+                onPropertiesChanged(mapping, message);
+            },
+            [this, mapping] {
+                bool active;
+                {
+                    std::lock_guard<std::mutex> lock(proxiesMutex_);
+                    active = activeServices_.count(mapping.service) > 0;
                 }
+                if (active) snapshotProperties(mapping);
             });
 
-        proxy->finishRegistration();
+        std::lock_guard<std::mutex> lock(proxiesMutex_);
+        propertySlots_[mapping] = std::move(slot);
+    } catch (const std::exception& e) {
+        std::cerr << "DbusManager: failed to add match rule " << rule
+                  << ": " << e.what() << std::endl;
+    }
+}
+
+void DbusManager::snapshotProperties(const PropertiesToMqttMapping& mapping) {
+    // Objects below a path_namespace cannot be enumerated without
+    // introspection; their cache fills from PropertiesChanged instead.
+    if (mapping.path.empty()) return;
 
+    try {
         std::lock_guard<std::mutex> lock(proxiesMutex_);
-        proxies_.push_back(std::move(proxy));
+        callProxy(mapping.service, mapping.path)
+            .callMethodAsync("GetAll")
+            .onInterface(kPropertiesInterface)
+            .withArguments(mapping.interface)
+            .uponReplyInvoke([this, mapping](const sdbus::Error* error,
+                                             std::map<std::string, sdbus::Variant> properties) {
+                if (error) {
+                    std::cerr << "DbusManager: GetAll " << mapping.interface
+                              << " on " << mapping.path << " failed: "
+                              << error->getMessage() << std::endl;
+                    return;
+                }
+                for (const auto& [name, value] : properties) {
+                    propertyCache_.set(mapping.service, mapping.path, mapping.interface, name, value);
+                    reportProperty(mapping, mapping.path, name, value);
+                }
+            });
+    } catch (const std::exception& e) {
+        std::cerr << "DbusManager: could not snapshot " << mapping.interface
+                  << " on " << mapping.path << ": " << e.what() << std::endl;
+    }
+}
 
+void DbusManager::onPropertiesChanged(const PropertiesToMqttMapping& mapping, sdbus::Message& message) {
+    std::string interface;
+    std::map<std::string, sdbus::Variant> changed;
+    std::vector<std::string> invalidated;
+    try {
+        message >> interface >> changed >> invalidated;
     } catch (const std::exception& e) {
-        // Log the failure but do not propagate — the NameOwnerChanged handler
-        // will retry when the service appears.
-        std::cerr << "DbusManager: failed to register signal handler for "
-                  << mapping.service << " " << mapping.signal
-                  << ": " << e.what()
-                  << " (will retry when service appears)" << std::endl;
+        std::cerr << "DbusManager: malformed PropertiesChanged from "
+                  << message.getSender() << ": " << e.what() << std::endl;
+        return;
+    }
+
+    const std::string path = message.getPath();
+    for (const auto& [name, value] : changed) {
+        propertyCache_.set(mapping.service, path, mapping.interface, name, value);
+        reportProperty(mapping, path, name, value);
+    }
+    for (const auto& name : invalidated) {
+        propertyCache_.invalidate(mapping.service, path, mapping.interface, name);
+        fetchProperty(mapping, path, name);
     }
 }
 
-// ── callMethod ────────────────────────────────────────────────────────────────
+void DbusManager::fetchProperty(const PropertiesToMqttMapping& mapping,
+                                const std::string& path, const std::string& name) {
+    try {
+        std::lock_guard<std::mutex> lock(proxiesMutex_);
+        callProxy(mapping.service, path)
+            .callMethodAsync("Get")
+            .onInterface(kPropertiesInterface)
+            .withArguments(mapping.interface, name)
+            .uponReplyInvoke([this, mapping, path, name](const sdbus::Error* error, sdbus::Variant value) {
+                if (error) {
+                    std::cerr << "DbusManager: Get " << mapping.interface << "." << name
+                              << " on " << path << " failed: " << error->getMessage() << std::endl;
+                    return;
+                }
+                propertyCache_.set(mapping.service, path, mapping.interface, name, value);
+                reportProperty(mapping, path, name, value);
+            });
+    } catch (const std::exception& e) {
+        std::cerr << "DbusManager: could not fetch " << mapping.interface << "." << name
+                  << " on " << path << ": " << e.what() << std::endl;
+    }
+}
+
+void DbusManager::reportProperty(const PropertiesToMqttMapping& mapping, const std::string& path,
+                                 const std::string& name, const sdbus::Variant& value) {
+    std::lock_guard<std::mutex> lock(reportMutex_);
+    if (propertyCallback_) propertyCallback_(mapping, path, name, value);
+}
 
-sdbus::Variant DbusManager::callMethod(const std::string& service,
-                                       const std::string& path,
-                                       const std::string& interface,
-                                       const std::string& method,
-                                       const std::vector<sdbus::Variant>& args) {
-    // Gate on whether the target service is currently known to be active.
+void DbusManager::republishProperties() {
+    std::vector<PropertiesToMqttMapping> propertyMappings;
     {
         std::lock_guard<std::mutex> lock(proxiesMutex_);
-        if (activeServices_.find(service) == activeServices_.end()) {
-            throw std::runtime_error(
-                "D-Bus service '" + service + "' is not currently available");
+        propertyMappings = propertyMappings_;
+    }
+    // Values are read from the cache under reportMutex_: anything set after
+    // the read is reported by the dispatch thread once we let go.
+    std::lock_guard<std::mutex> lock(reportMutex_);
+    if (!propertyCallback_) return;
+    for (const auto& mapping : propertyMappings) {
+        for (const auto& [path, properties] : propertyCache_.objects(mapping.service, mapping.interface)) {
+            if (!covers(mapping, path)) continue;
+            for (const auto& [name, value] : properties) {
+                propertyCallback_(mapping, path, name, value);
+            }
         }
     }
+}
 
-    auto proxy = sdbus::createProxy(*connection_, service, path);
-    auto methodCall = proxy->createMethodCall(interface, method);
+void DbusManager::watchProperties(const std::vector<MqttToDbusMapping>& mappings) {
+    std::set<ObjectKey> wanted;
+    for (const auto& m : mappings) {
+        if (m.action == "get") wanted.emplace(m.service, m.path, m.interface);
+    }
 
-    for (const auto& arg : args) {
-        if      (arg.containsValueOfType<std::string>())  methodCall << arg.get<std::string>();
-        else if (arg.containsValueOfType<int32_t>())      methodCall << arg.get<int32_t>();
-        else if (arg.containsValueOfType<uint32_t>())     methodCall << arg.get<uint32_t>();
-        else if (arg.containsValueOfType<bool>())         methodCall << arg.get<bool>();
-        else if (arg.containsValueOfType<double>())       methodCall << arg.get<double>();
-        else if (arg.containsValueOfType<int64_t>())      methodCall << arg.get<int64_t>();
-        else if (arg.containsValueOfType<uint64_t>())     methodCall << arg.get<uint64_t>();
-        else                                               methodCall << arg;
+    std::vector<ObjectKey> added;
+    std::vector<sdbus::Slot> retiredSlots;
+    {
+        std::lock_guard<std::mutex> lock(proxiesMutex_);
+        for (auto it = watchSlots_.begin(); it != watchSlots_.end(); ) {
+            if (wanted.count(it->first)) {
+                ++it;
+                continue;
+            }
+            watched_.erase(it->first);
+            retiredSlots.push_back(std::move(it->second));
+            it = watchSlots_.erase(it);
+        }
+        for (const auto& key : wanted) {
+            // Placeholder first, so an install callback that beats the
+            // assignment below still finds the key.
+            if (watchSlots_.try_emplace(key).second) added.push_back(key);
+        }
     }
+    retiredSlots.clear();
 
-    auto reply = proxy->callMethod(methodCall);
-    sdbus::Variant result;
-    if (reply.isValid()) {
+    for (const auto& key : added) {
+        PropertiesToMqttMapping object;  // only to build the match rule
+        std::tie(object.service, object.path, object.interface) = key;
+        const std::string rule = buildPropertiesMatchRule(object);
         try {
-            reply >> result;
-        } catch (...) {}
+            auto slot = addMatchAsync(rule,
+                [this, service = object.service, interface = object.interface](sdbus::Message& message) {
+                    onWatchedPropertiesChanged(service, interface, message);
+                },
+                [this, key] {
+                    std::lock_guard<std::mutex> lock(proxiesMutex_);
+                    if (watchSlots_.count(key)) watched_.insert(key);
+                });
+
+            std::lock_guard<std::mutex> lock(proxiesMutex_);
+            auto it = watchSlots_.find(key);
+            if (it != watchSlots_.end()) it->second = std::move(slot);
+        } catch (const std::exception& e) {
+            std::cerr << "DbusManager: failed to add match rule " << rule
+                      << ": " << e.what() << std::endl;
+        }
+    }
+}
+
+void DbusManager::onWatchedPropertiesChanged(const std::string& service, const std::string& interface,
+                                             sdbus::Message& message) {
+    std::string changedInterface;
+    std::map<std::string, sdbus::Variant> changed;
+    std::vector<std::string> invalidated;
+    try {
+        message >> changedInterface >> changed >> invalidated;
+    } catch (const std::exception& e) {
+        std::cerr << "DbusManager: malformed PropertiesChanged from "
+                  << message.getSender() << ": " << e.what() << std::endl;
+        return;
+    }
+
+    // Invalidated values are simply forgotten; the next get fetches them.
+    const std::string path = message.getPath();
+    for (const auto& [name, value] : changed) {
+        propertyCache_.set(service, path, interface, name, value);
+    }
+    for (const auto& name : invalidated) {
+        propertyCache_.invalidate(service, path, interface, name);
+    }
+}
+
+bool DbusManager::isMirrored(const std::string& service, const std::string& path,
+                             const std::string& interface) const {
+    if (watched_.count({service, path, interface})) return true;
+    for (const auto& m : propertyMappings_) {
+        if (m.service == service && m.interface == interface && covers(m, path)) return true;
+    }
+    return false;
+}
+
+void DbusManager::getProperty(const std::string& service, const std::string& path,
+                              const std::string& interface, const std::string& name,
+                              PropertyReply reply) {
+    bool active, mirrored;
+    {
+        std::lock_guard<std::mutex> lock(proxiesMutex_);
+        active   = activeServices_.find(service) != activeServices_.end();
+        mirrored = isMirrored(service, path, interface);
+    }
+    // Replies publish to MQTT; never run them with the lock held.
+    if (!active) {
+        reply({}, "D-Bus service '" + service + "' is not currently available");
+        return;
+    }
+
+    if (mirrored) {
+        if (auto cached = propertyCache_.get(service, path, interface, name)) {
+            reply(*cached, {});
+            return;
+        }
+    }
+
+    try {
+        std::lock_guard<std::mutex> lock(proxiesMutex_);
+        callProxy(service, path)
+            .callMethodAsync("Get")
+            .onInterface(kPropertiesInterface)
+            .withArguments(interface, name)
+            .uponReplyInvoke([this, service, path, interface, name, mirrored, reply = std::move(reply)]
+                             (const sdbus::Error* error, sdbus::Variant value) {
+                if (error) {
+                    reply({}, error->getMessage());
+                    return;
+                }
+                if (mirrored) propertyCache_.set(service, path, interface, name, value);
+                reply(value, {});
+            });
+    } catch (const std::exception& e) {
+        reply({}, e.what());
+    }
+}
+
+void DbusManager::setProperty(const std::string& service, const std::string& path,
+                              const std::string& interface, const std::string& name,
+                              const sdbus::Variant& value, CompletionCallback done) {
+    bool active, mirrored;
+    {
+        std::lock_guard<std::mutex> lock(proxiesMutex_);
+        active   = activeServices_.find(service) != activeServices_.end();
+        mirrored = isMirrored(service, path, interface);
+    }
+    if (!active) {
+        done("D-Bus service '" + service + "' is not currently available");
+        return;
     }
-    return result;
-}
\ No newline at end of file
+
+    // Optimistic: readers see the new value right away.  The service's own
+    // PropertiesChanged (if it emits one) overwrites it with the real value.
+    if (mirrored) propertyCache_.set(service, path, interface, name, value);
+
+    try {
+        std::lock_guard<std::mutex> lock(proxiesMutex_);
+        callProxy(service, path)
+            .callMethodAsync("Set")
+            .onInterface(kPropertiesInterface)
+            .withArguments(interface, name, value)
+            .uponReplyInvoke([this, service, path, interface, name, mirrored, done = std::move(done)]
+                             (const sdbus::Error* error) {
+                if (error) {
+                    if (mirrored) propertyCache_.invalidate(service, path, interface, name);
+                    done(error->getMessage());
+                    return;
+                }
+                done({});
+            });
+    } catch (const std::exception& e) {
+        if (mirrored) propertyCache_.invalidate(service, path, interface, name);
+        done(e.what());
+    }
+}
+
+sdbus::IProxy& DbusManager::callProxy(const std::string& service, const std::string& path) {
+    auto& proxy = callProxies_[{service, path}];
+    if (!proxy) {
+        proxy = sdbus::createProxy(*connection_, service, path);
+        proxy->finishRegistration();
+    }
+    return *proxy;
+}
+
+std::pair<size_t, size_t> DbusManager::updatePropertyMappings(
+    const std::vector<PropertiesToMqttMapping>& mappings)
+{
+    std::set<PropertiesToMqttMapping> wanted(mappings.begin(), mappings.end());
+    std::vector<PropertiesToMqttMapping> added;
+    std::vector<sdbus::Slot> retiredSlots;
+    size_t removed = 0;
+
+    {
+        std::lock_guard<std::mutex> lock(proxiesMutex_);
+        std::set<PropertiesToMqttMapping> current(propertyMappings_.begin(), propertyMappings_.end());
+
+        for (const auto& mapping : current) {
+            if (wanted.count(mapping)) continue;
+            ++removed;
+            auto it = propertySlots_.find(mapping);
+            if (it != propertySlots_.end()) {
+                retiredSlots.push_back(std::move(it->second));
+                propertySlots_.erase(it);
+            }
+        }
+        for (const auto& mapping : wanted) {
+            if (!current.count(mapping)) added.push_back(mapping);
+        }
+        propertyMappings_.assign(wanted.begin(), wanted.end());
+    }
+    retiredSlots.clear();
+
+    for (const auto& mapping : added) {
+        activatePropertyMapping(mapping);
+    }
+    return {added.size(), removed};
+}
+
+// ── updateMappings ────────────────────────────────────────────────────────────
+
+std::pair<size_t, size_t> DbusManager::updateMappings(
+    const std::vector<DbusToMqttMapping>& mappings)
+{
+    std::set<DbusToMqttMapping> wanted(mappings.begin(), mappings.end());
+    std::vector<DbusToMqttMapping> added;
+    std::vector<sdbus::Slot> retiredSlots;
+    size_t removed = 0;
+
+    {
+        std::lock_guard<std::mutex> lock(proxiesMutex_);
+        std::set<DbusToMqttMapping> current(mappings_.begin(), mappings_.end());
+
+        for (const auto& mapping : current) {
+            if (wanted.count(mapping)) continue;
+            ++removed;
+            auto slotIt = matchSlots_.find(mapping);
+            if (slotIt != matchSlots_.end()) {
+                retiredSlots.push_back(std::move(slotIt->second));
+                matchSlots_.erase(slotIt);
+            }
+        }
+        for (const auto& mapping : wanted) {
+            if (!current.count(mapping)) added.push_back(mapping);
+        }
+        mappings_.assign(wanted.begin(), wanted.end());
+    }
+
+    // Slots are destroyed outside the lock: their destructors remove match
+    // rules from the daemon.
+    retiredSlots.clear();
+
+    for (const auto& mapping : added) {
+        activateMapping(mapping);
+    }
+    return {added.size(), removed};
+}
+
+// ── callMethod ────────────────────────────────────────────────────────────────
+
+void DbusManager::callMethod(const std::string& service,
+                             const std::string& path,
+                             const std::string& interface,
+                             const std::string& method,
+                             const std::vector<sdbus::Variant>& args,
+                             MethodReplyCallback done) {
+    try {
+        std::lock_guard<std::mutex> lock(proxiesMutex_);
+        // Gate on whether the target service is currently known to be active.
+        if (activeServices_.find(service) == activeServices_.end()) {
+            throw std::runtime_error(
+                "D-Bus service '" + service + "' is not currently available");
+        }
+
+        auto& proxy = callProxy(service, path);
+        auto methodCall = proxy.createMethodCall(interface, method);
+
+        for (const auto& arg : args) {
+            if      (arg.containsValueOfType<std::string>())  methodCall << arg.get<std::string>();
+            else if (arg.containsValueOfType<int32_t>())      methodCall << arg.get<int32_t>();
+            else if (arg.containsValueOfType<uint32_t>())     methodCall << arg.get<uint32_t>();
+            else if (arg.containsValueOfType<bool>())         methodCall << arg.get<bool>();
+            else if (arg.containsValueOfType<double>())       methodCall << arg.get<double>();
+            else if (arg.containsValueOfType<int64_t>())      methodCall << arg.get<int64_t>();
+            else if (arg.containsValueOfType<uint64_t>())     methodCall << arg.get<uint64_t>();
+            else                                               methodCall << arg;
+        }
+
+        proxy.callMethod(methodCall, [done](sdbus::MethodReply& reply, const sdbus::Error* error) {
+            if (error) {
+                done({}, error->getName() + ": " + error->getMessage());
+                return;
+            }
+            done(TypeUtils::unpackSignal(reply), {});
+        });
+    } catch (const std::exception& e) {
+        done({}, e.what());
+    }
+}
@@ -19,6 +19,56 @@ void InteractiveSelector::cleanupNcurses() {
     endwin();
 }
 
+// ── Filter ────────────────────────────────────────────────────────────────────
+
+InteractiveSelector::Filter::Filter(const std::vector<std::string>& items)
+    : items_(items) {}
+
+void InteractiveSelector::Filter::push(char c) {
+    char lc = std::tolower(static_cast<unsigned char>(c));
+    std::vector<Match> next;
+    auto extend = [&](uint32_t item, uint32_t from) {
+        const std::string& s = items_[item];
+        for (uint32_t i = from; i < s.size(); ++i) {
+            if (std::tolower(static_cast<unsigned char>(s[i])) == lc) {
+                next.push_back({item, i + 1});
+                return;
+            }
+        }
+    };
+    
+    // The leftmost match of the longer filter extends the leftmost match of
+    // the shorter one, so only the previous survivors need looking at.
+    if (levels_.empty()) {
+        for (uint32_t i = 0; i < items_.size(); ++i) extend(i, 0);
+    } else {
+        for (const auto& m : levels_.back()) extend(m.item, m.end);
+    }
+    text_ += c;
+    levels_.push_back(std::move(next));
+}
+
+void InteractiveSelector::Filter::pop() {
+    if (levels_.empty()) return;
+    levels_.pop_back();
+    text_.pop_back();
+}
+
+void InteractiveSelector::Filter::clear() {
+    levels_.clear();
+    text_.clear();
+}
+
+size_t InteractiveSelector::Filter::size() const {
+    return levels_.empty() ? items_.size() : levels_.back().size();
+}
+
+size_t InteractiveSelector::Filter::at(size_t n) const {
+    return levels_.empty() ? n : levels_.back()[n].item;
+}
+
+// ── selectFromList ────────────────────────────────────────────────────────────
+
 std::optional<std::string> InteractiveSelector::selectFromList(
     const std::string& title,
     const std::vector<std::string>& items,
@@ -31,24 +81,34 @@ std::optional<std::string> InteractiveSelector::selectFromList(
     
     initNcurses();
     
+    Filter filter(items);
+    bool filtering = false;  // '/' pressed: q and m are filter text too
     int selected = 0;
     int offset = 0;
-    int max_display = LINES - 5;  // Leave room for header and footer
     
     while (true) {
-        clear();
+        int max_display = std::max(1, LINES - 6);  // Leave room for header, filter and footer
+        int count = (int)filter.size();
+        if (selected >= count) selected = std::max(0, count - 1);
+        
+        // erase() rather than clear(): curses then only redraws the cells
+        // that changed instead of repainting the whole terminal.
+        erase();
         
         // Title
         attron(A_BOLD);
-        mvprintw(0, 0, "%s", title.c_str());
+        mvaddnstr(0, 0, title.c_str(), COLS);
         attroff(A_BOLD);
-        mvprintw(1, 0, "Use arrow keys to navigate, Enter to select, q to quit");
+        mvprintw(1, 0, "Use arrow keys to navigate, Enter to select, type to filter, q to quit");
         if (allow_manual_entry) {
             mvprintw(2, 0, "Press 'm' to enter manually");
         }
         if (allow_navigation) {
             mvprintw(2, allow_manual_entry ? 40 : 0, "Right arrow: descend, Left arrow: go up");
         }
+        if (filtering || !filter.text().empty()) {
+            mvprintw(3, 0, "Filter: %s", filter.text().c_str());
+        }
         
         // Calculate visible range
         if (selected < offset) {
@@ -57,50 +117,58 @@ std::optional<std::string> InteractiveSelector::selectFromList(
         if (selected >= offset + max_display) {
             offset = selected - max_display + 1;
         }
+        offset = std::max(0, std::min(offset, count - max_display));
         
-        int visible_end = std::min(offset + max_display, (int)items.size());
+        int visible_end = std::min(offset + max_display, count);
         
-        // Show items
+        // Only the visible rows are drawn, however long the list
         for (int i = offset; i < visible_end; ++i) {
-            int y = 4 + (i - offset);
+            int y = 5 + (i - offset);
+            const std::string& item = items[filter.at(i)];
             
-            if (i == selected) {
-                attron(A_REVERSE);
-                mvprintw(y, 2, "> %s", items[i].c_str());
-                attroff(A_REVERSE);
-            } else {
-                mvprintw(y, 2, "  %s", items[i].c_str());
-            }
+            if (i == selected) attron(A_REVERSE);
+            mvaddstr(y, 2, i == selected ? "> " : "  ");
+            addnstr(item.c_str(), std::max(0, COLS - 4));
+            if (i == selected) attroff(A_REVERSE);
+        }
+        if (count == 0) {
+            mvprintw(5, 2, "(no matches)");
         }
         
         // Show scroll indicators
         if (offset > 0) {
-            mvprintw(3, 0, "^ More above");
+            mvprintw(4, 0, "^ More above");
         }
-        if (visible_end < (int)items.size()) {
-            mvprintw(4 + max_display, 0, "v More below");
+        if (visible_end < count) {
+            mvprintw(5 + max_display, 0, "v More below");
         }
         
         // Footer
-        mvprintw(LINES - 1, 0, "Showing %d-%d of %d items",
-                 offset + 1, visible_end, (int)items.size());
+        if (count == (int)items.size()) {
+            mvprintw(LINES - 1, 0, "Showing %d-%d of %d items",
+                     count ? offset + 1 : 0, visible_end, count);
+        } else {
+            mvprintw(LINES - 1, 0, "Showing %d-%d of %d matches (%d items)",
+                     count ? offset + 1 : 0, visible_end, count, (int)items.size());
+        }
         
         refresh();
         
         // Handle input
         int ch = getch();
+        bool editing = filtering || !filter.text().empty();
         switch (ch) {
             case KEY_UP:
                 if (selected > 0) selected--;
                 break;
             case KEY_DOWN:
-                if (selected < (int)items.size() - 1) selected++;
+                if (selected < count - 1) selected++;
                 break;
             case KEY_RIGHT:
-                if (allow_navigation) {
+                if (allow_navigation && count > 0) {
                     // Signal to descend into selected item
                     cleanupNcurses();
-                    return "<<DESCEND>>" + items[selected];
+                    return "<<DESCEND>>" + items[filter.at(selected)];
                 }
                 break;
             case KEY_LEFT:
@@ -114,32 +182,73 @@ std::optional<std::string> InteractiveSelector::selectFromList(
                 selected = std::max(0, selected - max_display);
                 break;
             case KEY_NPAGE:  // Page Down
-                selected = std::min((int)items.size() - 1, selected + max_display);
+                selected = std::max(0, std::min(count - 1, selected + max_display));
                 break;
             case KEY_HOME:
                 selected = 0;
                 break;
             case KEY_END:
-                selected = items.size() - 1;
+                selected = std::max(0, count - 1);
                 break;
             case 10:  // Enter
             case KEY_ENTER:
+                if (count > 0) {
+                    cleanupNcurses();
+                    return items[filter.at(selected)];
+                }
+                break;
+            case KEY_BACKSPACE:
+            case 127:
+            case 8:
+                if (!filter.text().empty()) {
+                    filter.pop();
+                } else {
+                    filtering = false;
+                }
+                break;
+            case 27:  // ESC: clear the filter first, quit when there is none
+                if (editing) {
+                    filter.clear();
+                    filtering = false;
+                    selected = offset = 0;
+                    break;
+                }
                 cleanupNcurses();
-                return items[selected];
+                return std::nullopt;
+            case '/':
+                if (!editing) {
+                    filtering = true;
+                    break;
+                }
+                filter.push((char)ch);
+                selected = offset = 0;
+                break;
             case 'q':
             case 'Q':
-            case 27:  // ESC
-                cleanupNcurses();
-                return std::nullopt;
+                if (!editing) {
+                    cleanupNcurses();
+                    return std::nullopt;
+                }
+                filter.push((char)ch);
+                selected = offset = 0;
+                break;
             case 'm':
             case 'M':
-                if (allow_manual_entry) {
+                if (!editing && allow_manual_entry) {
                     cleanupNcurses();
                     std::cout << "Enter manually: ";
                     std::string input;
                     std::getline(std::cin, input);
                     return "<<MANUAL>>" + input;
                 }
+                filter.push((char)ch);
+                selected = offset = 0;
+                break;
+            default:
+                if (ch >= 32 && ch <= 126) {  // Printable characters
+                    filter.push((char)ch);
+                    selected = offset = 0;
+                }
                 break;
         }
     }
@@ -0,0 +1,204 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2026 Ed Lee
+
+#include "IntrospectionXml.h"
+#include <stdexcept>
+
+namespace {
+
+struct Tag {
+    enum Kind { Open, Close, Empty };
+    Kind             kind = Open;
+    std::string_view name;
+    std::string_view attrs;   // everything between the name and '>' / '/>'
+};
+
+bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+// Yields element tags in document order, skipping text, comments,
+// processing instructions, CDATA and the DOCTYPE.
+class Scanner {
+public:
+    explicit Scanner(std::string_view xml) : xml_(xml) {}
+
+    bool next(Tag& tag) {
+        while (true) {
+            size_t lt = xml_.find('<', pos_);
+            if (lt == std::string_view::npos) return false;
+            pos_ = lt + 1;
+
+            std::string_view rest = xml_.substr(pos_);
+            if (rest.starts_with("!--"))       { skipPast("-->"); continue; }
+            if (rest.starts_with("![CDATA["))  { skipPast("]]>"); continue; }
+            if (rest.starts_with("?"))         { skipPast("?>");  continue; }
+            if (rest.starts_with("!"))         { skipPast(">");   continue; }
+
+            size_t end = tagEnd();
+            std::string_view body = xml_.substr(pos_, end - pos_);
+            pos_ = end + 1;
+
+            tag.kind = Tag::Open;
+            if (!body.empty() && body.front() == '/') {
+                tag.kind = Tag::Close;
+                body.remove_prefix(1);
+            } else if (!body.empty() && body.back() == '/') {
+                tag.kind = Tag::Empty;
+                body.remove_suffix(1);
+            }
+            size_t nameEnd = 0;
+            while (nameEnd < body.size() && !isSpace(body[nameEnd])) ++nameEnd;
+            tag.name  = body.substr(0, nameEnd);
+            tag.attrs = body.substr(nameEnd);
+            return true;
+        }
+    }
+
+private:
+    void skipPast(std::string_view terminator) {
+        size_t end = xml_.find(terminator, pos_);
+        if (end == std::string_view::npos) throw std::runtime_error("introspection XML: unterminated markup");
+        pos_ = end + terminator.size();
+    }
+
+    // Position of the '>' closing the current tag; '>' is legal inside
+    // quoted attribute values.
+    size_t tagEnd() const {
+        char quote = 0;
+        for (size_t i = pos_; i < xml_.size(); ++i) {
+            char c = xml_[i];
+            if (quote) {
+                if (c == quote) quote = 0;
+            } else if (c == '"' || c == '\'') {
+                quote = c;
+            } else if (c == '>') {
+                return i;
+            }
+        }
+        throw std::runtime_error("introspection XML: unterminated tag");
+    }
+
+    std::string_view xml_;
+    size_t           pos_ = 0;
+};
+
+// Raw (still entity-encoded) value of attribute `name`, or empty.
+std::string_view attribute(std::string_view attrs, std::string_view name) {
+    size_t i = 0;
+    while (i < attrs.size()) {
+        while (i < attrs.size() && isSpace(attrs[i])) ++i;
+        size_t keyStart = i;
+        while (i < attrs.size() && attrs[i] != '=' && !isSpace(attrs[i])) ++i;
+        std::string_view key = attrs.substr(keyStart, i - keyStart);
+        while (i < attrs.size() && (isSpace(attrs[i]) || attrs[i] == '=')) ++i;
+        if (i >= attrs.size()) break;
+
+        char quote = attrs[i];
+        if (quote != '"' && quote != '\'') break;
+        size_t valueEnd = attrs.find(quote, i + 1);
+        if (valueEnd == std::string_view::npos) {
+            throw std::runtime_error("introspection XML: unterminated attribute value");
+        }
+        if (key == name) return attrs.substr(i + 1, valueEnd - i - 1);
+        i = valueEnd + 1;
+    }
+    return {};
+}
+
+// Copies an attribute value, resolving the predefined entities.  Names and
+// signatures never contain any, so the common case is a plain copy.
+std::string decode(std::string_view raw) {
+    if (raw.find('&') == std::string_view::npos) return std::string(raw);
+
+    static constexpr std::pair<std::string_view, char> kEntities[] = {
+        {"&lt;", '<'}, {"&gt;", '>'}, {"&amp;", '&'}, {"&quot;", '"'}, {"&apos;", '\''},
+    };
+    std::string out;
+    out.reserve(raw.size());
+    for (size_t i = 0; i < raw.size();) {
+        bool matched = false;
+        if (raw[i] == '&') {
+            for (const auto& [entity, c] : kEntities) {
+                if (raw.substr(i).starts_with(entity)) {
+                    out += c;
+                    i += entity.size();
+                    matched = true;
+                    break;
+                }
+            }
+        }
+        if (!matched) out += raw[i++];
+    }
+    return out;
+}
+
+} // namespace
+
+const DbusInterface* DbusObject::findInterface(std::string_view name) const {
+    for (const auto& iface : interfaces) {
+        if (iface.name == name) return &iface;
+    }
+    return nullptr;
+}
+
+namespace IntrospectionXml {
+
+DbusObject parse(std::string_view xml) {
+    DbusObject object;
+    Scanner scanner(xml);
+    Tag tag;
+
+    int            nodeDepth = 0;          // 1 inside the object's own <node>
+    DbusInterface* iface     = nullptr;
+    DbusMember*    member    = nullptr;
+    bool           inSignal  = false;
+
+    while (scanner.next(tag)) {
+        if (tag.name == "node") {
+            if (tag.kind == Tag::Close) {
+                --nodeDepth;
+                continue;
+            }
+            if (nodeDepth == 1) {
+                auto name = attribute(tag.attrs, "name");
+                if (!name.empty()) object.children.push_back(decode(name));
+            }
+            if (tag.kind == Tag::Open) ++nodeDepth;
+            continue;
+        }
+        if (nodeDepth != 1) continue;
+
+        if (tag.name == "interface") {
+            if (tag.kind == Tag::Close) {
+                iface = nullptr;
+            } else {
+                object.interfaces.push_back({decode(attribute(tag.attrs, "name")), {}, {}, {}});
+                iface = (tag.kind == Tag::Open) ? &object.interfaces.back() : nullptr;
+            }
+        } else if (!iface) {
+            continue;
+        } else if (tag.name == "method" || tag.name == "signal") {
+            if (tag.kind == Tag::Close) {
+                member = nullptr;
+                continue;
+            }
+            inSignal = (tag.name == "signal");
+            auto& list = inSignal ? iface->signals : iface->methods;
+            list.push_back({decode(attribute(tag.attrs, "name")), {}});
+            member = (tag.kind == Tag::Open) ? &list.back() : nullptr;
+        } else if (tag.name == "arg" && member && tag.kind != Tag::Close) {
+            auto direction = attribute(tag.attrs, "direction");
+            member->args.push_back({decode(attribute(tag.attrs, "name")),
+                                    decode(attribute(tag.attrs, "type")),
+                                    direction.empty() ? (inSignal ? "out" : "in") : decode(direction)});
+        } else if (tag.name == "property" && tag.kind != Tag::Close) {
+            iface->properties.push_back({decode(attribute(tag.attrs, "name")),
+                                         decode(attribute(tag.attrs, "type")),
+                                         decode(attribute(tag.attrs, "access"))});
+        }
+    }
+    return object;
+}
+
+} // namespace IntrospectionXml
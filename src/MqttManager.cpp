@@ -2,34 +2,106 @@
 // Copyright (C) 2026 Ed Lee
 
 #include "MqttManager.h"
+#include "Reactor.h"
+#include "TopicFilter.h"
+#include "StartupTimings.h"
 #include <iostream>
 #include <chrono>
+#include <set>
+#include <map>
+#include <algorithm>
+#include <iterator>
+#include <random>
 
 // ── Backoff parameters ────────────────────────────────────────────────────────
-// Retry delay doubles on each failure up to the cap.
-static constexpr std::chrono::seconds kInitialRetryDelay{5};
-static constexpr std::chrono::seconds kMaxRetryDelay{60};
+// "Decorrelated jitter": each delay is drawn from [base, 3 × previous delay],
+// capped.  The first retry comes well under a second, and a fleet that lost
+// its broker at the same instant does not come back in lockstep.
+static constexpr std::chrono::milliseconds kBaseRetryDelay{250};
+static constexpr std::chrono::milliseconds kMaxRetryDelay{60000};
 
-MqttManager::MqttManager(const MqttConfig& config, const std::vector<MqttToDbusMapping>& mappings)
+// Topics per SUBSCRIBE/UNSUBSCRIBE packet; keeps packets well below broker
+// size limits while turning thousands of round trips into a handful.
+static constexpr size_t kTopicsPerPacket = 256;
+
+namespace {
+
+std::chrono::milliseconds nextRetryDelay(std::chrono::milliseconds previous) {
+    thread_local std::mt19937 rng{std::random_device{}()};
+    auto upper = std::max(kBaseRetryDelay, previous * 3);
+    std::uniform_int_distribution<long> dist(kBaseRetryDelay.count(), upper.count());
+    return std::min(std::chrono::milliseconds(dist(rng)), kMaxRetryDelay);
+}
+
+} // namespace
+
+MqttManager::MqttManager(const MqttConfig& config, const std::vector<MqttToDbusMapping>& mappings,
+                         Reactor* reactor)
+    : MqttManager(config, reactor, 0)
+{
+    mappings_ = mappings;
+    for (int i = 1; i < config_.connections; ++i) {
+        shards_.push_back(std::unique_ptr<MqttManager>(new MqttManager(config_, reactor, i)));
+    }
+}
+
+MqttManager::MqttManager(const MqttConfig& config, Reactor* reactor, int index)
     : config_(config)
-    , mappings_(mappings)
     , callback_(*this)
+    , connectListener_(*this)
+    , deliveryListener_(*this)
+    , index_(index)
+    , reactor_(reactor)
 {
-    std::string address = "tcp://" + config_.broker + ":" + std::to_string(config_.port);
-    client_ = std::make_unique<mqtt::async_client>(address, "dbus-mqtt-bridge");
+    serverUris_ = config_.serverUris();
+    const std::string& address = serverUris_.front();
+    // Client ids must be unique per broker, or the connections would keep
+    // taking each other over.
+    std::string clientId = "dbus-mqtt-bridge";
+    if (index > 0) clientId += "-" + std::to_string(index);
+    v5_ = (config_.version == 5);
+    client_ = v5_
+        ? std::make_unique<mqtt::async_client>(address, clientId,
+                                               mqtt::create_options(MQTTVERSION_5))
+        : std::make_unique<mqtt::async_client>(address, clientId);
     client_->set_callback(callback_);
 
     // Build connect options once; they are reused on every reconnect attempt.
+    if (v5_) {
+        // MQTT 5 replaces clean_session with clean_start plus a session
+        // expiry: the broker keeps our session (and subscriptions) only as
+        // long as configured.
+        connOpts_ = mqtt::connect_options::v5();
+        connOpts_.set_clean_start(false);
+        if (config_.session_expiry > 0) {
+            connOpts_.set_properties({{mqtt::property::SESSION_EXPIRY_INTERVAL, config_.session_expiry}});
+        }
+        if (config_.message_expiry > 0) {
+            publishProps_.add({mqtt::property::MESSAGE_EXPIRY_INTERVAL, config_.message_expiry});
+        }
+        for (const auto& [name, value] : config_.user_properties) {
+            publishProps_.add({mqtt::property::USER_PROPERTY, name, value});
+        }
+    } else {
+        // clean_session=false lets the broker remember our subscriptions across
+        // brief disconnections (QoS 1 messages queued during the gap are delivered
+        // on reconnect).  We still resubscribe explicitly after every connect to
+        // handle the case where the broker was restarted and lost its state.
+        connOpts_.set_clean_session(false);
+    }
     if (!config_.username.empty() && !config_.password.empty()) {
         connOpts_.set_user_name(config_.username);
         connOpts_.set_password(config_.password);
     }
-    // clean_session=false lets the broker remember our subscriptions across
-    // brief disconnections (QoS 1 messages queued during the gap are delivered
-    // on reconnect).  We still resubscribe explicitly after every connect to
-    // handle the case where the broker was restarted and lost its state.
-    connOpts_.set_clean_session(false);
     connOpts_.set_automatic_reconnect(false); // we manage reconnect ourselves
+
+    // Keep paho's own limit in step with our accounting so a publish never
+    // fails inside paho for lack of a slot.
+    maxInflight_ = static_cast<size_t>(config_.max_inflight);
+    maxQueued_   = static_cast<size_t>(config_.max_queued);
+    if (maxInflight_ > 0) connOpts_.set_max_inflight(config_.max_inflight);
+    if (config_.overflow_policy == "conflate")  overflow_ = Overflow::Conflate;
+    else if (config_.overflow_policy == "drop") overflow_ = Overflow::Drop;
 }
 
 MqttManager::~MqttManager() {
@@ -44,6 +116,9 @@ MqttManager::~MqttManager() {
     if (reconnectThread_.joinable()) {
         reconnectThread_.join();
     }
+    if (reactor_ && reconnectTimer_ >= 0) {
+        reactor_->disarmTimer(reconnectTimer_);
+    }
 
     if (client_ && client_->is_connected()) {
         try {
@@ -55,6 +130,19 @@ MqttManager::~MqttManager() {
 // ── Public API ────────────────────────────────────────────────────────────────
 
 void MqttManager::connect() {
+    connectCalled_ = Clock::now();
+    for (auto& shard : shards_) shard->connect();
+
+    if (reactor_) {
+        // Reactor mode: no reconnect thread.  The timer drives connection
+        // attempts on the reactor thread; paho reports the outcome through
+        // connectListener_, which re-arms the timer.
+        reconnectTimer_ = reactor_->addTimer([this] { onReconnectTimer(); });
+        retryDelayMs_ = 0;
+        scheduleReconnect(std::chrono::milliseconds::zero());
+        return;
+    }
+
     // Kick off the reconnect thread, which immediately attempts a first
     // connection.  This call returns immediately — the bridge does not block
     // waiting for MQTT to come up.
@@ -62,6 +150,8 @@ void MqttManager::connect() {
 }
 
 void MqttManager::disconnect() {
+    for (auto& shard : shards_) shard->disconnect();
+
     // Stop the reconnect loop first so it cannot race with the disconnect.
     {
         std::lock_guard<std::mutex> lock(reconnectMutex_);
@@ -73,6 +163,9 @@ void MqttManager::disconnect() {
     if (reconnectThread_.joinable()) {
         reconnectThread_.join();
     }
+    if (reactor_ && reconnectTimer_ >= 0) {
+        reactor_->disarmTimer(reconnectTimer_);
+    }
 
     try {
         if (client_->is_connected()) {
@@ -82,30 +175,354 @@ void MqttManager::disconnect() {
         std::cerr << "MQTT disconnect error: " << exc.what() << std::endl;
     }
     connected_ = false;
+
+    if (droppedOverflow_ > 0 || conflated_ > 0) {
+        std::cout << "MQTT flow control (" << client_->get_client_id() << "): "
+                  << droppedOverflow_.load() << " dropped, "
+                  << conflated_.load() << " conflated" << std::endl;
+    }
+    if (uint64_t connects = connects_.load()) {
+        std::cout << "MQTT connects: " << connects << ", average "
+                  << connectMsTotal_.load() / connects << " ms, max "
+                  << connectMsMax_.load() << " ms" << std::endl;
+    }
+    if (topicBytesSaved_ > 0) {
+        std::cout << "MQTT topic aliases saved " << topicBytesSaved_.load()
+                  << " bytes of topic names" << std::endl;
+    }
 }
 
-void MqttManager::publish(const std::string& topic, const std::string& payload) {
+MqttManager& MqttManager::route(const std::string& topic) {
+    if (shards_.empty()) return *this;
+    size_t index = std::hash<std::string>{}(topic) % (shards_.size() + 1);
+    return index == 0 ? *this : *shards_[index - 1];
+}
+
+bool MqttManager::publish(const std::string& topic, const std::string& payload,
+                          int qos, bool retain) {
+    MqttManager& conn = route(topic);
+    if (&conn != this) {
+        return conn.publish(topic, payload, qos, retain);
+    }
     if (!connected_) {
+        if (qos == 0) {
+            // High-rate telemetry would flood the log; count instead.
+            ++droppedQos0_;
+            return false;
+        }
         // Drop the message and warn.  A future improvement could buffer here.
         std::cerr << "MQTT not connected — dropping message on topic: " << topic << std::endl;
+        return false;
+    }
+    Outgoing msg;
+    msg.topic   = topic;
+    msg.payload = payload;
+    msg.qos     = qos;
+    msg.retain  = retain;
+    return enqueueOrSend(std::move(msg));
+}
+
+void MqttManager::publishReply(const std::string& topic, const std::string& payload,
+                               const std::string& correlationData) {
+    MqttManager& conn = route(topic);
+    if (&conn != this) {
+        conn.publishReply(topic, payload, correlationData);
         return;
     }
+    if (!connected_) {
+        std::cerr << "MQTT not connected — dropping reply on topic: " << topic << std::endl;
+        return;
+    }
+    // Correlation data only exists in MQTT 5; 3.1.1 callers rely on the id
+    // echoed in the payload.
+    Outgoing msg;
+    msg.topic           = topic;
+    msg.payload         = payload;
+    msg.correlationData = correlationData;
+    msg.reply           = true;
+    enqueueOrSend(std::move(msg));
+}
+
+// ── Flow control ──────────────────────────────────────────────────────────────
+
+bool MqttManager::admit(int qos) {
+    if (qos == 0 || maxInflight_ == 0 || overflow_ != Overflow::Drop) return true;
+    // The topic is not known yet, so only refuse when no connection could
+    // take the message.
+    if (hasRoom()) return true;
+    for (auto& shard : shards_) {
+        if (shard->hasRoom()) return true;
+    }
+    ++droppedOverflow_;
+    return false;
+}
+
+bool MqttManager::hasRoom() {
+    std::lock_guard<std::mutex> lock(flowMutex_);
+    return inflight_ < maxInflight_;
+}
+
+size_t MqttManager::inflight() const {
+    size_t total;
+    {
+        std::lock_guard<std::mutex> lock(flowMutex_);
+        total = inflight_;
+    }
+    for (const auto& shard : shards_) total += shard->inflight();
+    return total;
+}
+
+bool MqttManager::enqueueOrSend(Outgoing msg) {
+    // QoS 0 has no acknowledgement, so it never holds a slot.
+    if (msg.qos == 0 || maxInflight_ == 0) {
+        try {
+            send(msg, false);
+        } catch (const mqtt::exception& exc) {
+            std::cerr << "MQTT publish error: " << exc.what() << std::endl;
+            // The connection_lost callback will fire shortly and trigger reconnect.
+            return false;
+        }
+        return true;
+    }
+
+    // Sent under the lock so a message can never overtake one queued
+    // earlier on the same topic.
+    std::lock_guard<std::mutex> lock(flowMutex_);
+    if (inflight_ >= maxInflight_ || !pending_.empty()) {
+        return queueLocked(std::move(msg));
+    }
+    ++inflight_;
     try {
-        client_->publish(topic, payload, 1, false);
+        send(msg, true);
     } catch (const mqtt::exception& exc) {
+        --inflight_;
         std::cerr << "MQTT publish error: " << exc.what() << std::endl;
-        // The connection_lost callback will fire shortly and trigger reconnect.
+        return false;
+    }
+    return true;
+}
+
+bool MqttManager::queueLocked(Outgoing msg) {
+    if (!msg.reply) {
+        if (overflow_ == Overflow::Drop) {
+            ++droppedOverflow_;
+            return false;
+        }
+        if (overflow_ == Overflow::Conflate) {
+            auto it = pendingByTopic_.find(msg.topic);
+            if (it != pendingByTopic_.end()) {
+                // Keep the queue position, take the newest value.
+                it->second->payload = std::move(msg.payload);
+                it->second->qos     = msg.qos;
+                it->second->retain  = msg.retain;
+                ++conflated_;
+                return true;
+            }
+        }
+    }
+
+    if (pending_.size() >= maxQueued_) {
+        // Replies are never dropped: evict the oldest other message, and let
+        // a queue holding nothing but replies grow past the bound.
+        auto oldest = std::find_if(pending_.begin(), pending_.end(),
+                                   [](const Outgoing& m) { return !m.reply; });
+        if (oldest != pending_.end()) {
+            auto it = pendingByTopic_.find(oldest->topic);
+            if (it != pendingByTopic_.end() && it->second == oldest) pendingByTopic_.erase(it);
+            pending_.erase(oldest);
+            ++droppedOverflow_;
+        }
+    }
+
+    pending_.push_back(std::move(msg));
+    if (overflow_ == Overflow::Conflate && !pending_.back().reply) {
+        pendingByTopic_[pending_.back().topic] = std::prev(pending_.end());
+    }
+    return true;
+}
+
+void MqttManager::drainLocked() {
+    while (connected_ && inflight_ < maxInflight_ && !pending_.empty()) {
+        Outgoing msg = std::move(pending_.front());
+        auto it = pendingByTopic_.find(msg.topic);
+        if (it != pendingByTopic_.end() && it->second == pending_.begin()) pendingByTopic_.erase(it);
+        pending_.pop_front();
+
+        ++inflight_;
+        try {
+            send(msg, true);
+        } catch (const mqtt::exception& exc) {
+            --inflight_;
+            std::cerr << "MQTT publish error: " << exc.what() << std::endl;
+            return;
+        }
     }
 }
 
+void MqttManager::onDelivered() {
+    std::lock_guard<std::mutex> lock(flowMutex_);
+    if (inflight_ > 0) --inflight_;
+    drainLocked();
+}
+
+void MqttManager::DeliveryListener::on_success(const mqtt::token& /*tok*/) {
+    parent_.onDelivered();
+}
+
+void MqttManager::DeliveryListener::on_failure(const mqtt::token& tok) {
+    std::cerr << "MQTT delivery failed (rc " << tok.get_return_code() << ")" << std::endl;
+    parent_.onDelivered();
+}
+
 void MqttManager::setMessageCallback(MessageCallback cb) {
     messageCallback_ = std::move(cb);
 }
 
+void MqttManager::setConnectedCallback(ConnectedCallback cb) {
+    // A shard reconnecting alone has lost the messages routed to it too.
+    for (auto& shard : shards_) shard->setConnectedCallback(cb);
+    connectedCallback_ = std::move(cb);
+}
+
+std::pair<size_t, size_t> MqttManager::updateMappings(const std::vector<MqttToDbusMapping>& mappings) {
+    std::set<std::string> oldTopics, newTopics;
+    {
+        std::lock_guard<std::mutex> lock(mappingsMutex_);
+        for (const auto& m : mappings_) oldTopics.insert(m.topic);
+        for (const auto& m : mappings)  newTopics.insert(m.topic);
+        mappings_ = mappings;
+    }
+
+    size_t added = 0, removed = 0;
+    for (const auto& topic : newTopics) added   += !oldTopics.count(topic);
+    for (const auto& topic : oldTopics) removed += !newTopics.count(topic);
+
+    // While disconnected the next resubscribe() picks the changes up.
+    if (connected_) {
+        try {
+            syncSubscriptions();
+        } catch (const mqtt::exception& exc) {
+            std::cerr << "MQTT subscription update failed: " << exc.what() << std::endl;
+        }
+    }
+    return {added, removed};
+}
+
+void MqttManager::setPublishPrefixes(std::vector<std::string> prefixes) {
+    std::lock_guard<std::mutex> lock(mappingsMutex_);
+    publishPrefixes_ = std::move(prefixes);
+}
+
+// ── Private: MQTT 5 ───────────────────────────────────────────────────────────
+
+void MqttManager::send(const Outgoing& msg, bool tracked) {
+    mqtt::message_ptr message;
+    auto publish = [&] {
+        if (tracked) client_->publish(message, nullptr, deliveryListener_);
+        else         client_->publish(message);
+    };
+
+    if (!v5_) {
+        message = mqtt::message::create(msg.topic, msg.payload, msg.qos, msg.retain);
+        publish();
+        return;
+    }
+
+    mqtt::properties props = publishProps_;
+    if (!msg.correlationData.empty()) {
+        props.add({mqtt::property::CORRELATION_DATA, msg.correlationData});
+    }
+
+    // Look up and enqueue under one lock: a message that only carries the
+    // alias must not reach the socket before the one that establishes it.
+    std::lock_guard<std::mutex> lock(aliasMutex_);
+    auto alias = aliases_.lookup(msg.topic);
+    if (alias.alias != 0) {
+        props.add({mqtt::property::TOPIC_ALIAS, alias.alias});
+    }
+    if (alias.known) {
+        topicBytesSaved_ += msg.topic.size();
+    }
+    message = mqtt::message::create(alias.known ? std::string() : msg.topic,
+                                    msg.payload, msg.qos, msg.retain, props);
+    publish();
+}
+
+void MqttManager::onConnected(const mqtt::token& tok) {
+    sessionPresent_ = tok.get_connect_response().is_session_present();
+    if (uint64_t dropped = droppedQos0_.exchange(0)) {
+        std::cerr << "MQTT: dropped " << dropped
+                  << " QoS 0 messages while disconnected" << std::endl;
+    }
+    if (!sessionPresent_) {
+        // Without a session the unacknowledged messages are gone and their
+        // completions never arrive; start the window afresh.  With one,
+        // paho resends them and their completions still free their slots.
+        std::lock_guard<std::mutex> lock(flowMutex_);
+        inflight_ = 0;
+    }
+    if (!v5_) return;
+
+    // Aliases are only valid for the connection that set them up.  With a
+    // persistent session, paho may resend in-flight messages on a new
+    // connection, so aliasing is disabled altogether in that case.
+    int limit = 0;
+    if (config_.session_expiry == 0) {
+        const auto& props = tok.get_connect_response().get_properties();
+        int brokerMax = props.contains(mqtt::property::TOPIC_ALIAS_MAXIMUM)
+            ? mqtt::get<uint16_t>(props, mqtt::property::TOPIC_ALIAS_MAXIMUM)
+            : 0;
+        limit = std::min(config_.topic_aliases, brokerMax);
+    }
+
+    std::lock_guard<std::mutex> lock(aliasMutex_);
+    aliases_.reset(static_cast<uint16_t>(limit));
+}
+
 // ── Private: reconnect loop ───────────────────────────────────────────────────
 
+std::string MqttManager::beginAttempt() {
+    ++attempts_;
+    attemptStart_ = Clock::now();
+    if (serverUris_.size() == 1) return serverUris_.front();
+
+    // paho tries the list front to back within one connect.
+    size_t start = config_.failover == "round_robin" ? nextServer_++ % serverUris_.size() : 0;
+    auto servers = mqtt::string_collection::create();
+    for (size_t i = 0; i < serverUris_.size(); ++i) {
+        servers->push_back(serverUris_[(start + i) % serverUris_.size()]);
+    }
+    connOpts_.set_servers(servers);
+    return serverUris_[start] + " (+" + std::to_string(serverUris_.size() - 1) + " fallback)";
+}
+
+void MqttManager::recordConnect(const mqtt::token& tok) {
+    auto now = Clock::now();
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(now - attemptStart_).count();
+    connectMsTotal_ += ms;
+    ++connects_;
+    uint64_t max = connectMsMax_.load();
+    while (static_cast<uint64_t>(ms) > max && !connectMsMax_.compare_exchange_weak(max, ms)) {}
+
+    std::string uri = tok.get_connect_response().get_server_uri();
+    std::cout << "MQTT connected to " << (uri.empty() ? client_->get_server_uri() : uri)
+              << " in " << ms << " ms";
+    unsigned attempts = attempts_.exchange(0);
+    if (attempts > 1) std::cout << " (" << attempts << " attempts)";
+    if (auto lost = lostAt_.exchange(0)) {
+        auto outage = now - Clock::time_point(Clock::duration(lost));
+        std::cout << ", offline for "
+                  << std::chrono::duration_cast<std::chrono::milliseconds>(outage).count() << " ms";
+    }
+    std::cout << std::endl;
+    // Publish-only shards often connect first; the phase means the primary.
+    if (index_ == 0) {
+        StartupTimings::instance().record(StartupTimings::Phase::MqttConnect, connectCalled_);
+    }
+}
+
 void MqttManager::reconnectLoop() {
-    auto retryDelay = kInitialRetryDelay;
+    std::chrono::milliseconds retryDelay{0};
 
     while (true) {
         // Wait until either woken (reconnect needed) or stop requested.
@@ -117,61 +534,219 @@ void MqttManager::reconnectLoop() {
             reconnectNeeded_ = false;
         }
 
-        // Attempt connection with exponential backoff.
+        // Attempt connection with jittered backoff.
         while (!stopReconnect_) {
             try {
                 doConnect();
-                retryDelay = kInitialRetryDelay;  // reset on success
+                retryDelay = std::chrono::milliseconds{0};  // reset on success
                 break;
             } catch (const std::exception& e) {
+                retryDelay = nextRetryDelay(retryDelay);
                 std::cerr << "MQTT connection failed: " << e.what()
-                          << " — retrying in " << retryDelay.count() << "s" << std::endl;
+                          << " — retrying in " << retryDelay.count() << " ms" << std::endl;
             }
 
             // Wait for retryDelay, but wake immediately if stop is requested.
             std::unique_lock<std::mutex> lock(reconnectMutex_);
             reconnectCv_.wait_for(lock, retryDelay,
                                   [this] { return stopReconnect_.load(); });
-
-            // Double the delay up to the cap.
-            retryDelay = std::min(retryDelay * 2, kMaxRetryDelay);
         }
     }
 }
 
 void MqttManager::doConnect() {
-    std::cout << "Connecting to MQTT broker at "
-              << client_->get_server_uri() << "..." << std::endl;
-    client_->connect(connOpts_)->wait();
-    std::cout << "MQTT connected." << std::endl;
+    std::cout << "Connecting to MQTT broker at " << beginAttempt() << "..." << std::endl;
+    auto tok = client_->connect(connOpts_);
+    tok->wait();
+    recordConnect(*tok);
+    onConnected(*tok);
     connected_ = true;
+    {
+        std::lock_guard<std::mutex> lock(flowMutex_);
+        drainLocked();
+    }
     resubscribe();
+    if (connectedCallback_) connectedCallback_();
+}
+
+// ── Private: reactor-mode reconnect ───────────────────────────────────────────
+
+void MqttManager::scheduleReconnect(std::chrono::milliseconds delay) {
+    if (stopReconnect_) return;
+    reactor_->armTimer(reconnectTimer_, delay);
+}
+
+void MqttManager::onReconnectTimer() {
+    if (stopReconnect_) return;
+
+    if (connected_) {
+        // ConnectListener::on_success armed us: subscribe from the reactor
+        // thread, since blocking on SUBACKs inside a paho callback would
+        // stall paho's own receive thread.
+        try {
+            resubscribe();
+        } catch (const std::exception& e) {
+            std::cerr << "MQTT subscribe failed: " << e.what() << std::endl;
+        }
+        if (connectedCallback_) connectedCallback_();
+        return;
+    }
+
+    if (connecting_.exchange(true)) return;  // attempt already in flight
+
+    std::cout << "Connecting to MQTT broker at " << beginAttempt() << "..." << std::endl;
+    try {
+        client_->connect(connOpts_, nullptr, connectListener_);
+    } catch (const mqtt::exception& exc) {
+        connecting_ = false;
+        auto delay = nextRetryDelay(std::chrono::milliseconds(retryDelayMs_.load()));
+        std::cerr << "MQTT connection failed: " << exc.what()
+                  << " — retrying in " << delay.count() << " ms" << std::endl;
+        retryDelayMs_ = delay.count();
+        scheduleReconnect(delay);
+    }
+}
+
+void MqttManager::ConnectListener::on_success(const mqtt::token& tok) {
+    parent_.recordConnect(tok);
+    parent_.onConnected(tok);
+    parent_.retryDelayMs_ = 0;
+    parent_.connected_ = true;
+    parent_.connecting_ = false;
+    {
+        std::lock_guard<std::mutex> lock(parent_.flowMutex_);
+        parent_.drainLocked();
+    }
+    parent_.scheduleReconnect(std::chrono::milliseconds::zero());
+}
+
+void MqttManager::ConnectListener::on_failure(const mqtt::token& tok) {
+    auto delay = nextRetryDelay(std::chrono::milliseconds(parent_.retryDelayMs_.load()));
+    std::cerr << "MQTT connection failed (rc " << tok.get_return_code()
+              << ") — retrying in " << delay.count() << " ms" << std::endl;
+    parent_.retryDelayMs_ = delay.count();
+    parent_.connecting_ = false;
+    parent_.scheduleReconnect(delay);
 }
 
 void MqttManager::resubscribe() {
     // Called after every successful connect, whether first-time or after
-    // reconnect.  Ensures subscriptions are in place even if the broker was
-    // restarted and lost its session state.
-    for (const auto& mapping : mappings_) {
-        std::cout << "Subscribing to MQTT topic: " << mapping.topic << std::endl;
-        client_->subscribe(mapping.topic, 1)->wait();
+    // reconnect.  With clean_session=false (clean_start=false in MQTT 5) the
+    // broker normally still has our subscriptions and only changes made by a
+    // reload while disconnected need sending; if it lost the session (e.g.
+    // it was restarted) everything is subscribed again.
+    auto start = Clock::now();
+    {
+        std::lock_guard<std::mutex> lock(subscribeMutex_);
+        if (!sessionPresent_) subscribed_.clear();
+    }
+    syncSubscriptions();
+    if (index_ == 0) {
+        StartupTimings::instance().record(StartupTimings::Phase::MqttSubscribe, start);
+    }
+}
+
+std::map<std::string, int> MqttManager::mappingTopics(const std::vector<MqttToDbusMapping>& mappings) {
+    std::map<std::string, int> topics;
+    for (const auto& m : mappings) topics[m.topic] = std::max(topics[m.topic], m.qos);
+    return topics;
+}
+
+void MqttManager::syncSubscriptions() {
+    std::map<std::string, int> wanted;
+    std::vector<std::string> excluded;
+    {
+        std::lock_guard<std::mutex> lock(mappingsMutex_);
+        wanted = mappingTopics(mappings_);
+        excluded = publishPrefixes_;
+    }
+    if (config_.optimize_subscriptions && !wanted.empty()) {
+        // Bridge routes each message to its mapping, so anything extra a
+        // covering filter lets through is simply not dispatched.
+        auto covered = TopicFilter::cover(wanted, excluded);
+        if (covered.size() < wanted.size()) {
+            std::cout << "MQTT: " << wanted.size() << " mapping topics covered by "
+                      << covered.size() << " subscriptions" << std::endl;
+        }
+        wanted = std::move(covered);
+    }
+
+    std::lock_guard<std::mutex> lock(subscribeMutex_);
+    std::vector<std::pair<std::string, int>> subscribe;
+    std::vector<std::string> unsubscribe;
+    for (const auto& [topic, qos] : wanted) {
+        // Subscribing again to a known topic just replaces its QoS.
+        auto it = subscribed_.find(topic);
+        if (it == subscribed_.end() || it->second != qos) subscribe.emplace_back(topic, qos);
     }
+    for (const auto& [topic, qos] : subscribed_) {
+        if (!wanted.count(topic)) unsubscribe.push_back(topic);
+    }
+    if (subscribe.empty() && unsubscribe.empty()) return;
+
+    // Send every packet first, then wait: the broker handles them back to
+    // back and the whole update costs about one round trip.
+    // The first subscribe.size() / kTopicsPerPacket (rounded up) tokens
+    // are the SUBSCRIBEs, in order.
+    std::vector<mqtt::token_ptr> tokens;
+    for (size_t i = 0; i < subscribe.size(); i += kTopicsPerPacket) {
+        auto topics = mqtt::string_collection::create();
+        mqtt::qos_collection qos;
+        for (size_t j = i; j < std::min(i + kTopicsPerPacket, subscribe.size()); ++j) {
+            topics->push_back(subscribe[j].first);
+            qos.push_back(subscribe[j].second);
+        }
+        tokens.push_back(client_->subscribe(topics, qos));
+    }
+    for (size_t i = 0; i < unsubscribe.size(); i += kTopicsPerPacket) {
+        auto topics = mqtt::string_collection::create();
+        for (size_t j = i; j < std::min(i + kTopicsPerPacket, unsubscribe.size()); ++j) {
+            topics->push_back(unsubscribe[j]);
+        }
+        tokens.push_back(client_->unsubscribe(topics));
+    }
+    std::cout << "MQTT: subscribing to " << subscribe.size() << " and unsubscribing from "
+              << unsubscribe.size() << " topics in " << tokens.size() << " packets" << std::endl;
+    for (auto& tok : tokens) tok->wait();
+
+    // A refused filter (reason code 0x80 or above, also in MQTT 3.1.1) is
+    // not held by the session; leaving it out lets the next sync retry it.
+    for (size_t i = 0; i < subscribe.size(); i += kTopicsPerPacket) {
+        const auto codes = tokens[i / kTopicsPerPacket]->get_subscribe_response().get_reason_codes();
+        for (size_t j = i; j < std::min(i + kTopicsPerPacket, subscribe.size()); ++j) {
+            if (j - i < codes.size() && codes[j - i] >= 0x80) {
+                std::cerr << "MQTT: broker refused subscription to " << subscribe[j].first
+                          << " (reason " << static_cast<int>(codes[j - i]) << ")" << std::endl;
+                wanted.erase(subscribe[j].first);
+            }
+        }
+    }
+    subscribed_ = std::move(wanted);
 }
 
 // ── Callback inner class ──────────────────────────────────────────────────────
 
 void MqttManager::Callback::connected(const std::string& /*cause*/) {
-    // The paho async_client may fire this on automatic reconnect if we ever
-    // enable that option.  We do not currently, but handle it defensively.
-    std::cout << "MQTT connected (callback)." << std::endl;
-    parent_.connected_ = true;
-    parent_.resubscribe();
+    // paho fires this after every successful connect, racing the code that
+    // made it.  doConnect() and ConnectListener own the post-connect work:
+    // they have the CONNACK (session present, alias limit), and automatic
+    // reconnect is disabled, so nothing else ever connects.
 }
 
 void MqttManager::Callback::connection_lost(const std::string& cause) {
     std::cerr << "MQTT connection lost: "
               << (cause.empty() ? "(no reason given)" : cause) << std::endl;
     parent_.connected_ = false;
+    parent_.lostAt_ = Clock::now().time_since_epoch().count();
+    {
+        std::lock_guard<std::mutex> lock(parent_.aliasMutex_);
+        parent_.aliases_.reset(0);
+    }
+
+    if (parent_.reactor_) {
+        parent_.scheduleReconnect(std::chrono::milliseconds::zero());
+        return;
+    }
 
     // Wake the reconnect loop.
     {
@@ -182,9 +757,17 @@ void MqttManager::Callback::connection_lost(const std::string& cause) {
 }
 
 void MqttManager::Callback::message_arrived(mqtt::const_message_ptr msg) {
-    if (parent_.messageCallback_) {
-        parent_.messageCallback_(msg->get_topic(), msg->to_string());
+    if (!parent_.messageCallback_) return;
+
+    MessageProperties props;
+    const auto& mqttProps = msg->get_properties();
+    if (mqttProps.contains(mqtt::property::RESPONSE_TOPIC)) {
+        props.responseTopic = mqtt::get<std::string>(mqttProps, mqtt::property::RESPONSE_TOPIC);
+    }
+    if (mqttProps.contains(mqtt::property::CORRELATION_DATA)) {
+        props.correlationData = mqtt::get<mqtt::binary>(mqttProps, mqtt::property::CORRELATION_DATA);
     }
+    parent_.messageCallback_(msg->get_topic(), msg->to_string(), props);
 }
 
 void MqttManager::Callback::delivery_complete(mqtt::delivery_token_ptr /*token*/) {
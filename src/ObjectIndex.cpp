@@ -0,0 +1,63 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2026 Ed Lee
+
+#include "ObjectIndex.h"
+#include <algorithm>
+#include <cctype>
+
+namespace {
+
+constexpr std::string_view kStandardPrefix = "org.freedesktop.dbus.";
+
+char lower(char c) {
+    return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+}
+
+// `needle` must already be lower case.
+bool containsIgnoreCase(std::string_view haystack, std::string_view needle) {
+    auto it = std::search(haystack.begin(), haystack.end(), needle.begin(), needle.end(),
+                          [](char a, char b) { return lower(a) == b; });
+    return it != haystack.end();
+}
+
+bool startsWithIgnoreCase(std::string_view s, std::string_view prefix) {
+    return s.size() >= prefix.size() &&
+           std::equal(prefix.begin(), prefix.end(), s.begin(),
+                      [](char a, char b) { return a == lower(b); });
+}
+
+} // namespace
+
+void ObjectIndex::add(const std::string& path, DbusObject object) {
+    objects_.insert_or_assign(path, std::move(object));
+}
+
+std::vector<ObjectIndex::Hit> ObjectIndex::search(std::string_view needle, size_t limit) const {
+    std::string query(needle);
+    std::transform(query.begin(), query.end(), query.begin(), lower);
+    const bool wantStandard = query.find(kStandardPrefix.substr(0, kStandardPrefix.size() - 1)) != std::string::npos;
+
+    std::vector<Hit> hits;
+    std::string text;   // reused "<path> <interface>.<member>"
+    for (const auto& [path, object] : objects_) {
+        for (const auto& iface : object.interfaces) {
+            if (!wantStandard && startsWithIgnoreCase(iface.name, kStandardPrefix)) continue;
+
+            auto consider = [&](const std::string& member, MemberKind kind) {
+                text.assign(path).append(" ").append(iface.name).append(".").append(member);
+                if (containsIgnoreCase(text, query)) hits.push_back({path, iface.name, member, kind});
+                return hits.size() < limit;
+            };
+            for (const auto& m : iface.methods) {
+                if (!consider(m.name, MemberKind::Method)) return hits;
+            }
+            for (const auto& s : iface.signals) {
+                if (!consider(s.name, MemberKind::Signal)) return hits;
+            }
+            for (const auto& p : iface.properties) {
+                if (!consider(p.name, MemberKind::Property)) return hits;
+            }
+        }
+    }
+    return hits;
+}
@@ -0,0 +1,56 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2026 Ed Lee
+
+#include "PropertyCache.h"
+
+void PropertyCache::set(const std::string& service, const std::string& path,
+                        const std::string& interface, const std::string& name,
+                        const sdbus::Variant& value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    objects_[{service, path, interface}][name] = value;
+}
+
+void PropertyCache::invalidate(const std::string& service, const std::string& path,
+                               const std::string& interface, const std::string& name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = objects_.find({service, path, interface});
+    if (it != objects_.end()) it->second.erase(name);
+}
+
+std::optional<sdbus::Variant> PropertyCache::get(const std::string& service, const std::string& path,
+                                                 const std::string& interface,
+                                                 const std::string& name) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = objects_.find({service, path, interface});
+    if (it == objects_.end()) return std::nullopt;
+    auto prop = it->second.find(name);
+    if (prop == it->second.end()) return std::nullopt;
+    return prop->second;
+}
+
+PropertyCache::Properties PropertyCache::getAll(const std::string& service, const std::string& path,
+                                                const std::string& interface) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = objects_.find({service, path, interface});
+    return it == objects_.end() ? Properties{} : it->second;
+}
+
+std::map<std::string, PropertyCache::Properties>
+PropertyCache::objects(const std::string& service, const std::string& interface) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::map<std::string, Properties> result;
+    for (auto it = objects_.lower_bound({service, {}, {}});
+         it != objects_.end() && it->first.service == service; ++it) {
+        if (it->first.interface == interface) result.emplace(it->first.path, it->second);
+    }
+    return result;
+}
+
+void PropertyCache::dropService(const std::string& service) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Keys sort by service first, so the service's objects are contiguous.
+    auto it = objects_.lower_bound({service, {}, {}});
+    while (it != objects_.end() && it->first.service == service) {
+        it = objects_.erase(it);
+    }
+}
@@ -0,0 +1,191 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2026 Ed Lee
+
+#include "Reactor.h"
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/signalfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+#include <csignal>
+#include <cerrno>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <iostream>
+
+namespace {
+
+std::runtime_error sysError(const std::string& what) {
+    return std::runtime_error("Reactor: " + what + ": " + std::strerror(errno));
+}
+
+} // namespace
+
+Reactor::Reactor() {
+    epollFd_ = epoll_create1(EPOLL_CLOEXEC);
+    if (epollFd_ < 0) throw sysError("epoll_create1");
+
+    wakeFd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wakeFd_ < 0) {
+        ::close(epollFd_);
+        throw sysError("eventfd");
+    }
+
+    // The wake fd only exists to interrupt epoll_wait(); draining it is all
+    // the handler has to do since run() re-checks running_ every iteration.
+    addFd(wakeFd_, EPOLLIN, [this] {
+        uint64_t value;
+        while (::read(wakeFd_, &value, sizeof(value)) > 0) {}
+    });
+}
+
+Reactor::~Reactor() {
+    for (int timer : timers_) ::close(timer);
+    if (signalFd_ >= 0) ::close(signalFd_);
+    if (wakeFd_ >= 0)   ::close(wakeFd_);
+    if (epollFd_ >= 0)  ::close(epollFd_);
+}
+
+// ── fd watches ────────────────────────────────────────────────────────────────
+
+void Reactor::addFd(int fd, uint32_t events, Handler handler) {
+    epoll_event ev{};
+    ev.events  = events;
+    ev.data.fd = fd;
+    if (epoll_ctl(epollFd_, EPOLL_CTL_ADD, fd, &ev) < 0) {
+        throw sysError("epoll_ctl(ADD, " + std::to_string(fd) + ")");
+    }
+    handlers_[fd] = std::move(handler);
+}
+
+void Reactor::modifyFd(int fd, uint32_t events) {
+    epoll_event ev{};
+    ev.events  = events;
+    ev.data.fd = fd;
+    if (epoll_ctl(epollFd_, EPOLL_CTL_MOD, fd, &ev) < 0) {
+        throw sysError("epoll_ctl(MOD, " + std::to_string(fd) + ")");
+    }
+}
+
+void Reactor::removeFd(int fd) {
+    epoll_ctl(epollFd_, EPOLL_CTL_DEL, fd, nullptr);
+    handlers_.erase(fd);
+}
+
+// ── timers ────────────────────────────────────────────────────────────────────
+
+int Reactor::addTimer(Handler handler) {
+    int timer = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (timer < 0) throw sysError("timerfd_create");
+
+    addFd(timer, EPOLLIN, [timer, handler = std::move(handler)] {
+        // Consume the expiration count so the fd stops being readable, then
+        // run the callback.  The handler may re-arm the timer.
+        uint64_t expirations;
+        if (::read(timer, &expirations, sizeof(expirations)) > 0) {
+            handler();
+        }
+    });
+    timers_.push_back(timer);
+    return timer;
+}
+
+void Reactor::armTimer(int timer, std::chrono::milliseconds delay) {
+    // An all-zero it_value disarms a timerfd, so "fire now" is 1ns.
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(delay).count();
+    if (ns <= 0) ns = 1;
+
+    itimerspec spec{};
+    spec.it_value.tv_sec  = ns / 1000000000;
+    spec.it_value.tv_nsec = ns % 1000000000;
+    if (timerfd_settime(timer, 0, &spec, nullptr) < 0) {
+        throw sysError("timerfd_settime");
+    }
+}
+
+void Reactor::disarmTimer(int timer) {
+    itimerspec spec{};
+    timerfd_settime(timer, 0, &spec, nullptr);
+}
+
+void Reactor::removeTimer(int timer) {
+    removeFd(timer);
+    timers_.erase(std::remove(timers_.begin(), timers_.end(), timer), timers_.end());
+    ::close(timer);
+}
+
+// ── signals ───────────────────────────────────────────────────────────────────
+
+void Reactor::watchSignals(const std::vector<int>& signals, SignalHandler handler) {
+    sigset_t mask;
+    sigemptyset(&mask);
+    for (int signo : signals) sigaddset(&mask, signo);
+
+    // Blocked signals stay pending for the signalfd instead of interrupting
+    // whichever thread happens to be running.  Threads created later inherit
+    // this mask, which is why this has to happen before paho starts its own.
+    if (pthread_sigmask(SIG_BLOCK, &mask, nullptr) != 0) {
+        throw std::runtime_error("Reactor: pthread_sigmask failed");
+    }
+
+    signalFd_ = signalfd(-1, &mask, SFD_NONBLOCK | SFD_CLOEXEC);
+    if (signalFd_ < 0) throw sysError("signalfd");
+
+    signalHandler_ = std::move(handler);
+    addFd(signalFd_, EPOLLIN, [this] {
+        signalfd_siginfo info;
+        while (::read(signalFd_, &info, sizeof(info)) == sizeof(info)) {
+            if (signalHandler_) signalHandler_(static_cast<int>(info.ssi_signo));
+        }
+    });
+}
+
+// ── loop ──────────────────────────────────────────────────────────────────────
+
+void Reactor::addPrepareHook(PrepareHook hook) {
+    prepareHooks_.push_back(std::move(hook));
+}
+
+void Reactor::run() {
+    static constexpr int kMaxEvents = 16;
+    epoll_event events[kMaxEvents];
+
+    running_ = true;
+    while (running_) {
+        int timeout = -1;
+        for (auto& hook : prepareHooks_) {
+            int hint = hook();
+            if (hint >= 0 && (timeout < 0 || hint < timeout)) timeout = hint;
+        }
+        if (!running_) break;
+
+        int n = epoll_wait(epollFd_, events, kMaxEvents, timeout);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            throw sysError("epoll_wait");
+        }
+
+        for (int i = 0; i < n; ++i) {
+            // Look the handler up on every event: an earlier handler in this
+            // batch may have removed the fd.  Run a copy so a handler can
+            // remove its own registration.
+            auto it = handlers_.find(events[i].data.fd);
+            if (it == handlers_.end()) continue;
+            Handler handler = it->second;
+            try {
+                handler();
+            } catch (const std::exception& e) {
+                std::cerr << "Reactor: handler for fd " << events[i].data.fd
+                          << " threw: " << e.what() << std::endl;
+            }
+        }
+    }
+}
+
+void Reactor::stop() {
+    running_ = false;
+    uint64_t one = 1;
+    [[maybe_unused]] auto rc = ::write(wakeFd_, &one, sizeof(one));
+}
@@ -0,0 +1,69 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2026 Ed Lee
+
+#include "StartupTimings.h"
+#include <iomanip>
+#include <iterator>
+#include <iostream>
+#include <sstream>
+
+namespace {
+
+constexpr const char* kPhaseNames[] = {
+    "config_search", "config_load", "validation", "dbus_connect",
+    "list_names", "mapping_activation", "mqtt_connect", "mqtt_subscribe",
+};
+static_assert(std::size(kPhaseNames) == size_t(StartupTimings::Phase::Count));
+
+} // namespace
+
+StartupTimings& StartupTimings::instance() {
+    static StartupTimings timings;
+    return timings;
+}
+
+void StartupTimings::record(Phase phase, Clock::duration elapsed) {
+    std::function<void(const std::string&)> callback;
+    std::ostringstream summary;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto& slot = ms_[size_t(phase)];
+        if (slot || totalMs_) return;
+        slot = std::chrono::duration<double, std::milli>(elapsed).count();
+
+        for (const auto& ms : ms_) {
+            if (!ms) return;
+        }
+        totalMs_ = std::chrono::duration<double, std::milli>(Clock::now() - start_).count();
+
+        summary << std::fixed << std::setprecision(1) << "Startup:";
+        for (size_t i = 0; i < ms_.size(); ++i) {
+            summary << (i ? ", " : " ") << kPhaseNames[i] << ' ' << *ms_[i] << " ms";
+        }
+        summary << "; total " << *totalMs_ << " ms";
+        callback = std::move(onComplete_);
+    }
+
+    std::cout << summary.str() << std::endl;
+    if (callback) callback(toJson());
+}
+
+void StartupTimings::onComplete(std::function<void(const std::string& json)> callback) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    onComplete_ = std::move(callback);
+}
+
+std::string StartupTimings::toJson() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::ostringstream json;
+    json << std::fixed << std::setprecision(3) << "{\"startup_ms\":{";
+    bool first = true;
+    for (size_t i = 0; i < ms_.size(); ++i) {
+        if (!ms_[i]) continue;
+        json << (first ? "" : ",") << '"' << kPhaseNames[i] << "\":" << *ms_[i];
+        first = false;
+    }
+    if (totalMs_) json << (first ? "" : ",") << "\"total\":" << *totalMs_;
+    json << "}}";
+    return json.str();
+}
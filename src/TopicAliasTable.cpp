@@ -0,0 +1,71 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2026 Ed Lee
+
+#include "TopicAliasTable.h"
+
+void TopicAliasTable::reset(uint16_t maxAliases) {
+    maxAliases_ = maxAliases;
+    nextAlias_  = 1;
+    lookups_    = 0;
+    aliased_.clear();
+    candidates_.clear();
+    victim_.clear();
+}
+
+TopicAliasTable::Assignment TopicAliasTable::lookup(const std::string& topic) {
+    if (maxAliases_ == 0) return {};
+    if (++lookups_ >= kDecayInterval + aliased_.size()) decay();
+
+    auto it = aliased_.find(topic);
+    if (it != aliased_.end()) {
+        Assignment a{it->second.alias, it->second.known};
+        it->second.known = true;
+        ++it->second.hits;
+        return a;
+    }
+
+    unsigned count = ++candidates_[topic];
+    if (count < kHotThreshold) {
+        if (candidates_.size() > kMaxCandidates) decay();
+        return {};
+    }
+
+    uint16_t alias;
+    if (nextAlias_ <= maxAliases_) {
+        alias = static_cast<uint16_t>(nextAlias_++);
+    } else {
+        // Table full: only a topic busier than the coldest aliased one
+        // since the last decay may take its alias over.
+        auto victim = victim_.empty() ? aliased_.end() : aliased_.find(victim_);
+        if (victim == aliased_.end() || count <= victim->second.hits) return {};
+        alias = victim->second.alias;
+        aliased_.erase(victim);
+        victim_.clear();
+    }
+
+    // This message carries the topic name alongside the alias; later ones
+    // can omit it.
+    candidates_.erase(topic);
+    aliased_.emplace(topic, Entry{alias, true, count});
+    return {alias, false};
+}
+
+void TopicAliasTable::decay() {
+    lookups_ = 0;
+    for (auto it = candidates_.begin(); it != candidates_.end(); ) {
+        it->second /= 2;
+        if (it->second == 0) it = candidates_.erase(it);
+        else ++it;
+    }
+    if (candidates_.size() > kMaxCandidates) candidates_.clear();
+
+    victim_.clear();
+    unsigned coldest = 0;
+    for (auto& [topic, entry] : aliased_) {
+        entry.hits /= 2;
+        if (victim_.empty() || entry.hits < coldest) {
+            victim_ = topic;
+            coldest = entry.hits;
+        }
+    }
+}
@@ -0,0 +1,114 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2026 Ed Lee
+
+#include "TopicFilter.h"
+#include <algorithm>
+#include <cstdint>
+
+namespace {
+
+std::vector<std::string_view> splitLevels(std::string_view topic) {
+    std::vector<std::string_view> levels;
+    size_t start = 0;
+    while (true) {
+        size_t slash = topic.find('/', start);
+        levels.push_back(topic.substr(start, slash == std::string_view::npos ? slash : slash - start));
+        if (slash == std::string_view::npos) return levels;
+        start = slash + 1;
+    }
+}
+
+// One topic level of the subscription trie.  `qos` is -1 unless a
+// subscription ends here; `topics` and `maxQos` summarize the subtree.
+struct Node {
+    std::map<std::string, Node, std::less<>> children;
+    int    qos     = -1;
+    size_t topics  = 0;
+    int    maxQos  = 0;
+    bool   blocked = false;   // collapsing here would cover an excluded prefix
+};
+
+void summarize(Node& node) {
+    node.topics = node.qos >= 0 ? 1 : 0;
+    node.maxQos = std::max(node.qos, 0);
+    for (auto& [level, child] : node.children) {
+        summarize(child);
+        node.topics += child.topics;
+        node.maxQos = std::max(node.maxQos, child.maxQos);
+    }
+}
+
+void blockSubtree(Node& node) {
+    node.blocked = true;
+    for (auto& [level, child] : node.children) blockSubtree(child);
+}
+
+// Blocks every node whose "<prefix>/#" would match something under the
+// excluded prefix: its ancestors (including '+' levels) and its subtree.
+void block(Node& node, const std::vector<std::string_view>& levels, size_t i) {
+    node.blocked = true;
+    if (i == levels.size() || levels[i] == "#") {
+        blockSubtree(node);
+        return;
+    }
+    for (std::string_view key : {levels[i], std::string_view("+")}) {
+        auto it = node.children.find(key);
+        if (it != node.children.end()) block(it->second, levels, i + 1);
+        if (levels[i] == "+") break;
+    }
+}
+
+void emit(const Node& node, const std::string& prefix, size_t depth,
+          size_t minTopics, size_t minLevels, std::map<std::string, int>& out) {
+    if (depth >= minLevels && !node.blocked && node.topics >= minTopics) {
+        out[prefix + "/#"] = node.maxQos;
+        return;
+    }
+    if (node.qos >= 0) out[prefix] = node.qos;
+    for (const auto& [level, child] : node.children) {
+        // '#' has no levels below it; '$' topics are broker-internal or
+        // shared subscriptions and are always kept as configured.
+        bool literalOnly = level == "#" || (depth == 0 && !level.empty() && level[0] == '$');
+        emit(child, depth == 0 ? level : prefix + "/" + level, depth + 1,
+             minTopics, literalOnly ? SIZE_MAX : minLevels, out);
+    }
+}
+
+} // namespace
+
+namespace TopicFilter {
+
+bool matches(std::string_view filter, std::string_view topic) {
+    auto f = splitLevels(filter);
+    auto t = splitLevels(topic);
+    if (!topic.empty() && topic[0] == '$' && !f.empty() && (f[0] == "+" || f[0] == "#")) {
+        return false;
+    }
+    for (size_t i = 0; i < f.size(); ++i) {
+        if (f[i] == "#") return true;
+        if (i >= t.size()) return false;
+        if (f[i] != "+" && f[i] != t[i]) return false;
+    }
+    return f.size() == t.size();
+}
+
+std::map<std::string, int> cover(const std::map<std::string, int>& topics,
+                                 const std::vector<std::string>& excluded,
+                                 size_t minTopics, size_t minLevels) {
+    Node root;
+    for (const auto& [topic, qos] : topics) {
+        Node* node = &root;
+        for (auto level : splitLevels(topic)) {
+            node = &node->children[std::string(level)];
+        }
+        node->qos = std::max(node->qos, qos);
+    }
+    summarize(root);
+    for (const auto& prefix : excluded) block(root, splitLevels(prefix), 0);
+
+    std::map<std::string, int> out;
+    emit(root, std::string(), 0, minTopics, minLevels, out);
+    return out;
+}
+
+} // namespace TopicFilter
@@ -0,0 +1,109 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// Copyright (C) 2026 Ed Lee
+
+#include "TopicTemplate.h"
+#include <nlohmann/json.hpp>
+#include <charconv>
+
+namespace {
+
+// Appends an argument value, replacing characters that would turn a publish
+// topic into a filter or an invalid topic.
+void appendSanitized(std::string& out, std::string_view value) {
+    for (char c : value) {
+        out.push_back((c == '+' || c == '#' || c == '\0') ? '_' : c);
+    }
+}
+
+} // namespace
+
+bool TopicTemplate::isTemplate(std::string_view topic) {
+    return topic.find('{') != std::string_view::npos ||
+           topic.find('}') != std::string_view::npos;
+}
+
+std::optional<TopicTemplate> TopicTemplate::parse(std::string_view topic, std::string* error) {
+    auto fail = [&](const std::string& message) -> std::optional<TopicTemplate> {
+        if (error) *error = message;
+        return std::nullopt;
+    };
+
+    TopicTemplate tpl;
+    size_t pos = 0;
+    while (pos < topic.size()) {
+        size_t open = topic.find_first_of("{}", pos);
+        if (open == std::string_view::npos) {
+            tpl.segments_.push_back({Kind::Literal, std::string(topic.substr(pos)), 0});
+            break;
+        }
+        if (topic[open] == '}') {
+            return fail("unmatched '}' at position " + std::to_string(open));
+        }
+        if (open > pos) {
+            tpl.segments_.push_back({Kind::Literal, std::string(topic.substr(pos, open - pos)), 0});
+        }
+
+        size_t close = topic.find('}', open + 1);
+        if (close == std::string_view::npos) {
+            return fail("unterminated '{' at position " + std::to_string(open));
+        }
+        std::string_view name = topic.substr(open + 1, close - open - 1);
+
+        Segment seg;
+        if      (name == "service")   seg.kind = Kind::Service;
+        else if (name == "sender")    seg.kind = Kind::Sender;
+        else if (name == "path")      seg.kind = Kind::Path;
+        else if (name == "interface") seg.kind = Kind::Interface;
+        else if (name == "member")    seg.kind = Kind::Member;
+        else if (name == "property")  seg.kind = Kind::Property;
+        else if (name.size() > 3 && name.substr(0, 3) == "arg") {
+            std::string_view digits = name.substr(3);
+            auto [ptr, ec] = std::from_chars(digits.data(), digits.data() + digits.size(), seg.arg);
+            if (ec != std::errc() || ptr != digits.data() + digits.size()) {
+                return fail("invalid placeholder '{" + std::string(name) + "}'");
+            }
+            seg.kind = Kind::Arg;
+        } else {
+            return fail("unknown placeholder '{" + std::string(name) + "}'");
+        }
+        tpl.segments_.push_back(std::move(seg));
+        pos = close + 1;
+    }
+    return tpl;
+}
+
+void TopicTemplate::render(const TopicContext& ctx, std::string& out) const {
+    out.clear();
+    for (const auto& seg : segments_) {
+        switch (seg.kind) {
+            case Kind::Literal:   out += seg.text; break;
+            case Kind::Service:   out += ctx.service; break;
+            case Kind::Sender:    out += ctx.sender; break;
+            case Kind::Path:
+                out += ctx.path.empty() || ctx.path[0] != '/' ? ctx.path : ctx.path.substr(1);
+                break;
+            case Kind::Interface: out += ctx.interface; break;
+            case Kind::Member:    out += ctx.member; break;
+            case Kind::Property:  out += ctx.property; break;
+            case Kind::Arg:
+                if (ctx.args && seg.arg < ctx.args->size()) {
+                    const auto& value = (*ctx.args)[seg.arg];
+                    if (value.is_string()) {
+                        appendSanitized(out, value.get_ref<const std::string&>());
+                    } else {
+                        appendSanitized(out, value.dump());
+                    }
+                }
+                break;
+        }
+    }
+}
+
+std::string TopicTemplate::sample(std::string_view filler) const {
+    std::string out;
+    for (const auto& seg : segments_) {
+        if (seg.kind == Kind::Literal) out += seg.text;
+        else                           out += filler;
+    }
+    return out;
+}
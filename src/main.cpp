@@ -6,20 +6,95 @@
 #include <chrono>
 #include <csignal>
 #include <atomic>
+#include <memory>
+#include <sys/epoll.h>
 #include "CLI.h"
 #include "ConfigSearch.h"
 #include "ConfigGenerator.h"
 #include "Config.h"
+#include "ConfigCache.h"
+#include "ConfigFragments.h"
 #include "ConfigValidator.h"
 #include "Bridge.h"
+#include "Reactor.h"
+#include "ConfigWatcher.h"
+#include "StartupTimings.h"
 
 std::atomic<bool> running{true};
+std::atomic<bool> reloadRequested{false};
 
 void signalHandler(int signal) {
     std::cout << "\nReceived signal " << signal << ", shutting down..." << std::endl;
     running = false;
 }
 
+void reloadSignalHandler(int /*signal*/) {
+    reloadRequested = true;
+}
+
+// Re-reads and validates the config file and its conf.d fragments, then hands
+// the result to the running bridge.  An invalid config is reported and the
+// running one is kept.  Only fragments that changed are parsed again.
+static void reloadConfig(Bridge& bridge, const std::string& path, ConfigFragments& fragments) {
+    std::cout << "Reloading configuration from " << path << "..." << std::endl;
+    try {
+        ValidationResult validation;
+        Config config = ConfigCache::load(path, fragments, validation);
+        if (validation.hasErrors()) {
+            ConfigValidator::printValidationErrors(validation);
+            std::cerr << "Reload aborted; keeping the running configuration." << std::endl;
+            return;
+        }
+        bridge.reload(config);
+    } catch (const std::exception& e) {
+        std::cerr << "Reload failed: " << e.what()
+                  << "; keeping the running configuration." << std::endl;
+    }
+}
+
+// event_loop: reactor — one epoll loop on the main thread replaces the sdbus
+// event loop thread, the MQTT reconnect thread and the 1s polling loop used in
+// threaded mode.  Signals arrive through a signalfd, so shutdown is immediate.
+static int runReactor(const Config& config, const std::string& configPath,
+                      ConfigFragments& fragments) {
+    Reactor reactor;
+    Bridge* bridgePtr = nullptr;
+
+    // Must happen before the Bridge exists so paho's threads inherit the
+    // blocked signal mask and every signal is routed to the signalfd.
+    reactor.watchSignals({SIGINT, SIGTERM, SIGHUP}, [&](int signo) {
+        if (signo == SIGHUP) {
+            if (bridgePtr) reloadConfig(*bridgePtr, configPath, fragments);
+            return;
+        }
+        std::cout << "\nReceived signal " << signo << ", shutting down..." << std::endl;
+        reactor.stop();
+    });
+
+    std::cout << "Initializing bridge (reactor mode)..." << std::endl;
+    Bridge bridge(config, &reactor);
+    bridgePtr = &bridge;
+
+    std::unique_ptr<ConfigWatcher> watcher;
+    if (config.watch_config) {
+        watcher = std::make_unique<ConfigWatcher>(configPath, fragments.directory());
+        reactor.addFd(watcher->fd(), EPOLLIN, [&] {
+            if (watcher->consumeEvents()) reloadConfig(bridge, configPath, fragments);
+        });
+    }
+
+    std::cout << "Starting bridge..." << std::endl;
+    bridge.start();
+
+    std::cout << "Bridge is running. Press Ctrl+C to stop." << std::endl;
+    reactor.run();
+
+    // Disconnects cleanly and prints the MQTT and routing counters.
+    bridge.stop();
+    std::cout << "Bridge stopped." << std::endl;
+    return 0;
+}
+
 int main(int argc, char** argv) {
     // Parse CLI arguments
     CLIMode mode = CLI::parseArguments(argc, argv);
@@ -41,12 +116,16 @@ int main(int argc, char** argv) {
             return 1;
             
         case CLIMode::RUN_BRIDGE:
-            // Continue with normal bridge operation
+        case CLIMode::PRINT_SUBSCRIPTIONS:
+            // Both need the validated configuration
             break;
     }
     
     // Find config file
+    auto& timings = StartupTimings::instance();
+    auto searchStart = StartupTimings::Clock::now();
     auto configPath = ConfigSearch::findConfigFile(argc, argv);
+    timings.record(StartupTimings::Phase::ConfigSearch, searchStart);
     if (!configPath) {
         std::cerr << "Error: No configuration file found." << std::endl;
         std::cerr << "\nSearched locations:" << std::endl;
@@ -60,11 +139,10 @@ int main(int argc, char** argv) {
 
     try {
         std::cout << "Loading configuration from " << *configPath << "..." << std::endl;
-        Config config = Config::loadFromFile(*configPath);
-
-        // Validate configuration
-        std::cout << "Validating configuration..." << std::endl;
-        ValidationResult validation = config.validate();
+        // Parses and validates, or reuses the snapshot of an unchanged file
+        ConfigFragments fragments(ConfigFragments::directoryFor(*configPath));
+        ValidationResult validation;
+        Config config = ConfigCache::load(*configPath, fragments, validation);
         
         if (validation.hasErrors()) {
             ConfigValidator::printValidationErrors(validation);
@@ -80,23 +158,51 @@ int main(int argc, char** argv) {
         
         std::cout << "Configuration valid." << std::endl;
 
+        if (mode == CLIMode::PRINT_SUBSCRIPTIONS) {
+            for (const auto& [filter, qos] : Bridge::subscriptions(config)) {
+                std::cout << "Subscription: " << filter << " qos " << qos << std::endl;
+            }
+            return 0;
+        }
+
+        if (config.event_loop == "reactor") {
+            return runReactor(config, *configPath, fragments);
+        }
+
         std::cout << "Initializing bridge..." << std::endl;
         Bridge bridge(config);
 
         // Set up signal handlers
         std::signal(SIGINT, signalHandler);
         std::signal(SIGTERM, signalHandler);
+        std::signal(SIGHUP, reloadSignalHandler);
+
+        std::unique_ptr<ConfigWatcher> watcher;
+        if (config.watch_config) {
+            watcher = std::make_unique<ConfigWatcher>(*configPath, fragments.directory());
+        }
 
         std::cout << "Starting bridge..." << std::endl;
         bridge.start();
 
         std::cout << "Bridge is running. Press Ctrl+C to stop." << std::endl;
         
-        // Keep main thread alive
+        // Keep main thread alive; reloads are applied from here so they never
+        // run inside a signal handler or a library callback thread.
         while (running) {
-            std::this_thread::sleep_for(std::chrono::seconds(1));
+            if (watcher) {
+                if (watcher->waitForChange(std::chrono::seconds(1))) {
+                    reloadRequested = true;
+                }
+            } else {
+                std::this_thread::sleep_for(std::chrono::seconds(1));
+            }
+            if (reloadRequested.exchange(false)) {
+                reloadConfig(bridge, *configPath, fragments);
+            }
         }
         
+        bridge.stop();
         std::cout << "Bridge stopped." << std::endl;
 
     } catch (const std::exception& e) {
@@ -0,0 +1,133 @@
+#!/bin/bash
+# SPDX-License-Identifier: GPL-3.0-or-later
+# Copyright (C) 2026 Ed Lee
+
+# Cold-start test for properties_to_mqtt: after the bridge starts, the
+# retained topics must hold the values of the startup GetAll snapshot.
+# Mirrors the properties of the bus daemon itself (org.freedesktop.DBus on a
+# private session bus), so no simulator is needed.
+#
+# Two cases: the broker is already up when the bridge starts, and the broker
+# only comes up after the snapshot has been taken.
+#
+# Needs a built binary, dbus-run-session, mosquitto and mosquitto_sub.
+
+set -e
+
+if [ -f "./build/dbus-mqtt-bridge" ]; then
+    BINARY="$(pwd)/build/dbus-mqtt-bridge"
+elif [ -f "/usr/bin/dbus-mqtt-bridge" ]; then
+    BINARY="/usr/bin/dbus-mqtt-bridge"
+else
+    echo "Error: dbus-mqtt-bridge binary not found"
+    echo "Tried: ./build/dbus-mqtt-bridge and /usr/bin/dbus-mqtt-bridge"
+    exit 1
+fi
+
+echo "Using binary: $BINARY"
+echo
+
+# Colors for output
+RED='\033[0;31m'
+GREEN='\033[0;32m'
+YELLOW='\033[1;33m'
+NC='\033[0m' # No Color
+
+WORK="$(mktemp -d)"
+PORT=$((20000 + RANDOM % 10000))
+BROKER_PID=""
+BRIDGE_PID=""
+FAILED=0
+cleanup() {
+    [ -n "$BRIDGE_PID" ] && kill -INT "$BRIDGE_PID" 2>/dev/null
+    [ -n "$BROKER_PID" ] && kill "$BROKER_PID" 2>/dev/null
+    rm -rf "$WORK"
+}
+trap cleanup EXIT
+
+cat > "$WORK/config.yaml" <<EOF
+mqtt:
+  broker: localhost
+  port: $PORT
+bus_type: session
+mappings:
+  properties_to_mqtt:
+    - service: "org.freedesktop.DBus"
+      path: "/org/freedesktop/DBus"
+      interface: "org.freedesktop.DBus"
+      topic: "test/dbus"
+EOF
+
+# A fresh broker without persistence, so no retained message survives from
+# an earlier case.
+start_broker() {
+    mosquitto -p "$PORT" >"$WORK/mosquitto.log" 2>&1 &
+    BROKER_PID=$!
+    sleep 0.5
+}
+
+stop_broker() {
+    kill "$BROKER_PID" 2>/dev/null || true
+    wait "$BROKER_PID" 2>/dev/null || true
+    BROKER_PID=""
+}
+
+start_bridge() {
+    XDG_CACHE_HOME="$WORK/cache" CACHE_DIRECTORY= \
+        dbus-run-session -- "$BINARY" "$WORK/config.yaml" >"$WORK/bridge.log" 2>&1 &
+    BRIDGE_PID=$!
+}
+
+stop_bridge() {
+    kill -INT "$BRIDGE_PID" 2>/dev/null || true
+    wait "$BRIDGE_PID" 2>/dev/null || true
+    BRIDGE_PID=""
+}
+
+# Waits for the bridge's startup summary, i.e. MQTT connected and every
+# mapping active.
+wait_started() {
+    for ((t = 0; t < 300; t++)); do
+        grep -q "^Startup:" "$WORK/bridge.log" && return 0
+        sleep 0.1
+    done
+    return 1
+}
+
+# Retained messages are delivered right after subscribing; the Features
+# property exists on every dbus-daemon and dbus-broker.
+check_retained() {
+    local name=$1
+    sleep 0.5
+    if mosquitto_sub -p "$PORT" -t "test/dbus/#" -W 2 -v 2>/dev/null | grep -q "^test/dbus/Features "; then
+        echo -e "${GREEN}✓ PASS${NC}: $name"
+    else
+        echo -e "${RED}✗ FAIL${NC}: $name"
+        tail -5 "$WORK/bridge.log"
+        FAILED=1
+    fi
+}
+
+# Test 1: broker up before the bridge starts
+echo -e "${YELLOW}Test 1: Retained properties after cold start${NC}"
+start_broker
+start_bridge
+wait_started || true
+check_retained "Startup snapshot retained on the broker"
+stop_bridge
+stop_broker
+echo
+
+# Test 2: the snapshot is taken while the broker is still down; it must be
+# sent once the connection comes up.
+echo -e "${YELLOW}Test 2: Retained properties when the broker starts late${NC}"
+start_bridge
+sleep 2
+start_broker
+wait_started || true
+check_retained "Snapshot sent after the late connect"
+stop_bridge
+stop_broker
+echo
+
+exit $FAILED
@@ -208,6 +208,473 @@ else
 fi
 echo
 
+# Test 9: Invalid Event Loop
+echo -e "${YELLOW}Test 9: Invalid Event Loop${NC}"
+cat > "$TEST_DIR/invalid-event-loop.yaml" <<EOF
+mqtt:
+  broker: localhost
+  port: 1883
+bus_type: system
+event_loop: "poll"
+mappings:
+  dbus_to_mqtt: []
+  mqtt_to_dbus: []
+EOF
+
+if $BINARY "$TEST_DIR/invalid-event-loop.yaml" 2>&1 | grep -q "Invalid event_loop"; then
+    echo -e "${GREEN}✓ PASS${NC}: Caught invalid event loop"
+else
+    echo -e "${RED}✗ FAIL${NC}: Did not catch invalid event loop"
+fi
+echo
+
+# Test 10: Wildcard Mapping With Both path and path_namespace
+echo -e "${YELLOW}Test 10: path and path_namespace Together${NC}"
+cat > "$TEST_DIR/path-and-namespace.yaml" <<EOF
+mqtt:
+  broker: localhost
+  port: 1883
+bus_type: system
+mappings:
+  dbus_to_mqtt:
+    - path: "/org/example"
+      path_namespace: "/org/example"
+      interface: "org.example.Test"
+      topic: "test/topic"
+  mqtt_to_dbus: []
+EOF
+
+if $BINARY "$TEST_DIR/path-and-namespace.yaml" 2>&1 | grep -q "Exactly one of 'path' or 'path_namespace'"; then
+    echo -e "${GREEN}✓ PASS${NC}: Caught conflicting path and path_namespace"
+else
+    echo -e "${RED}✗ FAIL${NC}: Did not catch conflicting path and path_namespace"
+fi
+echo
+
+# Test 11: Unknown Topic Template Placeholder
+echo -e "${YELLOW}Test 11: Unknown Topic Template Placeholder${NC}"
+cat > "$TEST_DIR/invalid-topic-template.yaml" <<EOF
+mqtt:
+  broker: localhost
+  port: 1883
+bus_type: system
+mappings:
+  dbus_to_mqtt:
+    - service: "org.example.Service"
+      path: "/org/example"
+      interface: "org.example.Test"
+      signal: "Changed"
+      topic: "test/{object}/{member}"
+  mqtt_to_dbus: []
+EOF
+
+if $BINARY "$TEST_DIR/invalid-topic-template.yaml" 2>&1 | grep -q "unknown placeholder"; then
+    echo -e "${GREEN}✓ PASS${NC}: Caught unknown topic template placeholder"
+else
+    echo -e "${RED}✗ FAIL${NC}: Did not catch unknown topic template placeholder"
+fi
+echo
+
+# Test 12: Invalid properties_to_mqtt Mapping
+echo -e "${YELLOW}Test 12: Invalid properties_to_mqtt Mapping${NC}"
+cat > "$TEST_DIR/invalid-properties-mapping.yaml" <<EOF
+mqtt:
+  broker: localhost
+  port: 1883
+bus_type: system
+mappings:
+  dbus_to_mqtt: []
+  properties_to_mqtt:
+    - service: "org.freedesktop.UPower"
+      path: "/org/freedesktop/UPower/devices/DisplayDevice"
+      interface: "invalid-interface"
+      topic: "upower/display"
+  mqtt_to_dbus: []
+EOF
+
+if $BINARY "$TEST_DIR/invalid-properties-mapping.yaml" 2>&1 | grep -q "properties_to_mqtt\[0\].interface"; then
+    echo -e "${GREEN}✓ PASS${NC}: Caught invalid interface in properties_to_mqtt mapping"
+else
+    echo -e "${RED}✗ FAIL${NC}: Did not catch invalid interface in properties_to_mqtt mapping"
+fi
+echo
+
+# Test 13: Property Get Without reply_topic
+echo -e "${YELLOW}Test 13: Property Get Without reply_topic${NC}"
+cat > "$TEST_DIR/get-without-reply-topic.yaml" <<EOF
+mqtt:
+  broker: localhost
+  port: 1883
+bus_type: system
+mappings:
+  dbus_to_mqtt: []
+  mqtt_to_dbus:
+    - topic: "audio/volume/get"
+      service: "org.example.Audio"
+      path: "/org/example/Audio"
+      interface: "org.example.Audio"
+      action: get
+      property: "Volume"
+EOF
+
+if $BINARY "$TEST_DIR/get-without-reply-topic.yaml" 2>&1 | grep -q "'reply_topic' is required"; then
+    echo -e "${GREEN}✓ PASS${NC}: Caught property get without reply_topic"
+else
+    echo -e "${RED}✗ FAIL${NC}: Did not catch property get without reply_topic"
+fi
+echo
+
+# Test 14: Invalid MQTT Version
+echo -e "${YELLOW}Test 14: Invalid MQTT Version${NC}"
+cat > "$TEST_DIR/invalid-mqtt-version.yaml" <<EOF
+mqtt:
+  broker: localhost
+  port: 1883
+  version: 4
+bus_type: system
+mappings:
+  dbus_to_mqtt: []
+  mqtt_to_dbus: []
+EOF
+
+if $BINARY "$TEST_DIR/invalid-mqtt-version.yaml" 2>&1 | grep -q "Invalid MQTT version"; then
+    echo -e "${GREEN}✓ PASS${NC}: Caught invalid MQTT version"
+else
+    echo -e "${RED}✗ FAIL${NC}: Did not catch invalid MQTT version"
+fi
+echo
+
+# Test 15: Invalid Mapping QoS
+echo -e "${YELLOW}Test 15: Invalid Mapping QoS${NC}"
+cat > "$TEST_DIR/invalid-qos.yaml" <<EOF
+mqtt:
+  broker: localhost
+  port: 1883
+bus_type: system
+mappings:
+  dbus_to_mqtt:
+    - service: "org.example.Service"
+      path: "/org/example"
+      interface: "org.example.Test"
+      signal: "Changed"
+      topic: "test/topic"
+      qos: 3
+  mqtt_to_dbus: []
+EOF
+
+if $BINARY "$TEST_DIR/invalid-qos.yaml" 2>&1 | grep -q "Invalid QoS"; then
+    echo -e "${GREEN}✓ PASS${NC}: Caught invalid mapping QoS"
+else
+    echo -e "${RED}✗ FAIL${NC}: Did not catch invalid mapping QoS"
+fi
+echo
+
+# Test 16: Invalid Overflow Policy
+echo -e "${YELLOW}Test 16: Invalid Overflow Policy${NC}"
+cat > "$TEST_DIR/invalid-overflow-policy.yaml" <<EOF
+mqtt:
+  broker: localhost
+  port: 1883
+  overflow_policy: lossy
+bus_type: system
+mappings:
+  dbus_to_mqtt: []
+  mqtt_to_dbus: []
+EOF
+
+if $BINARY "$TEST_DIR/invalid-overflow-policy.yaml" 2>&1 | grep -q "Invalid overflow_policy"; then
+    echo -e "${GREEN}✓ PASS${NC}: Caught invalid overflow policy"
+else
+    echo -e "${RED}✗ FAIL${NC}: Did not catch invalid overflow policy"
+fi
+echo
+
+# Test 17: Invalid Connection Count
+echo -e "${YELLOW}Test 17: Invalid Connection Count${NC}"
+cat > "$TEST_DIR/invalid-connections.yaml" <<EOF
+mqtt:
+  broker: localhost
+  port: 1883
+  connections: 0
+bus_type: system
+mappings:
+  dbus_to_mqtt: []
+  mqtt_to_dbus: []
+EOF
+
+if $BINARY "$TEST_DIR/invalid-connections.yaml" 2>&1 | grep -q "Invalid connections"; then
+    echo -e "${GREEN}✓ PASS${NC}: Caught invalid connection count"
+else
+    echo -e "${RED}✗ FAIL${NC}: Did not catch invalid connection count"
+fi
+echo
+
+# Test 18: Invalid Fallback Broker
+echo -e "${YELLOW}Test 18: Invalid Fallback Broker${NC}"
+cat > "$TEST_DIR/invalid-fallback-broker.yaml" <<EOF
+mqtt:
+  broker: localhost
+  port: 1883
+  brokers:
+    - "backup.example.com:99999"
+bus_type: system
+mappings:
+  dbus_to_mqtt: []
+  mqtt_to_dbus: []
+EOF
+
+if $BINARY "$TEST_DIR/invalid-fallback-broker.yaml" 2>&1 | grep -q "Invalid port in broker"; then
+    echo -e "${GREEN}✓ PASS${NC}: Caught invalid fallback broker"
+else
+    echo -e "${RED}✗ FAIL${NC}: Did not catch invalid fallback broker"
+fi
+echo
+
+# Test 19: Conflicting conf.d Fragment
+echo -e "${YELLOW}Test 19: Conflicting conf.d Fragment${NC}"
+mkdir -p "$TEST_DIR/fragments/conf.d"
+cat > "$TEST_DIR/fragments/config.yaml" <<EOF
+mqtt:
+  broker: localhost
+  port: 1883
+bus_type: system
+mappings:
+  mqtt_to_dbus:
+    - topic: "home/light/set"
+      service: "org.example.Light"
+      path: "/org/example/Light"
+      interface: "org.example.Light"
+      method: "Set"
+EOF
+cat > "$TEST_DIR/fragments/conf.d/50-light.yaml" <<EOF
+mappings:
+  mqtt_to_dbus:
+    - topic: "home/light/set"
+      service: "org.example.OtherLight"
+      path: "/org/example/Light"
+      interface: "org.example.Light"
+      method: "Set"
+EOF
+
+if $BINARY "$TEST_DIR/fragments/config.yaml" 2>&1 | grep -q "is already used by"; then
+    echo -e "${GREEN}✓ PASS${NC}: Caught conflicting conf.d fragment"
+else
+    echo -e "${RED}✗ FAIL${NC}: Did not catch conflicting conf.d fragment"
+fi
+echo
+
+# Test 20: Invalid Metrics Topic
+echo -e "${YELLOW}Test 20: Invalid Metrics Topic${NC}"
+cat > "$TEST_DIR/invalid-metrics-topic.yaml" <<EOF
+mqtt:
+  broker: localhost
+  port: 1883
+  metrics_topic: "dbus-mqtt-bridge/#"
+bus_type: system
+mappings:
+  dbus_to_mqtt: []
+  mqtt_to_dbus: []
+EOF
+
+if $BINARY "$TEST_DIR/invalid-metrics-topic.yaml" 2>&1 | grep -q "mqtt.metrics_topic"; then
+    echo -e "${GREEN}✓ PASS${NC}: Caught invalid metrics topic"
+else
+    echo -e "${RED}✗ FAIL${NC}: Did not catch invalid metrics topic"
+fi
+echo
+
+# Test 21: Invalid Heartbeat
+echo -e "${YELLOW}Test 21: Invalid Heartbeat${NC}"
+cat > "$TEST_DIR/invalid-heartbeat.yaml" <<EOF
+mqtt:
+  broker: localhost
+  port: 1883
+bus_type: system
+mappings:
+  dbus_to_mqtt:
+    - service: "org.freedesktop.NetworkManager"
+      path: "/org/freedesktop/NetworkManager"
+      interface: "org.freedesktop.NetworkManager"
+      signal: "StateChanged"
+      topic: "network/state"
+      on_change: true
+      heartbeat: -30
+  mqtt_to_dbus: []
+EOF
+
+if $BINARY "$TEST_DIR/invalid-heartbeat.yaml" 2>&1 | grep -q "dbus_to_mqtt\[0\].heartbeat"; then
+    echo -e "${GREEN}✓ PASS${NC}: Caught negative heartbeat"
+else
+    echo -e "${RED}✗ FAIL${NC}: Did not catch negative heartbeat"
+fi
+echo
+
+# Test 22: Subscription Minimization
+echo -e "${YELLOW}Test 22: Subscription Minimization${NC}"
+cat > "$TEST_DIR/subscription-cover.yaml" <<EOF
+mqtt:
+  broker: localhost
+  port: 1883
+  optimize_subscriptions: true
+  # Published by the bridge itself, so office/blinds must not be covered
+  metrics_topic: "office/blinds/metrics"
+bus_type: system
+mappings:
+  dbus_to_mqtt:
+    # The bridge publishes below sensors/in, so it must not be covered
+    - service: "org.example.Sensors"
+      path: "/org/example/Sensors"
+      interface: "org.example.Sensors"
+      signal: "Status"
+      topic: "sensors/in/status"
+  mqtt_to_dbus:
+    # Four topics below home/lights: covered by home/lights/# with the
+    # highest QoS of the four
+    - topic: "home/lights/kitchen/set"
+      service: "org.example.Lights"
+      path: "/org/example/Lights/kitchen"
+      interface: "org.example.Light"
+      method: "Set"
+      qos: 2
+    - topic: "home/lights/hall/set"
+      service: "org.example.Lights"
+      path: "/org/example/Lights/hall"
+      interface: "org.example.Light"
+      method: "Set"
+    - topic: "home/lights/bath/set"
+      service: "org.example.Lights"
+      path: "/org/example/Lights/bath"
+      interface: "org.example.Light"
+      method: "Set"
+      qos: 0
+    - topic: "home/lights/garage/set"
+      service: "org.example.Lights"
+      path: "/org/example/Lights/garage"
+      interface: "org.example.Light"
+      method: "Set"
+    # A wildcard mapping overlapping three exact ones: plant/line1/#
+    - topic: "plant/line1/+/cmd"
+      service: "org.example.Plant"
+      path: "/org/example/Plant"
+      interface: "org.example.Plant"
+      method: "Command"
+    - topic: "plant/line1/press/cmd"
+      service: "org.example.Plant"
+      path: "/org/example/Plant/press"
+      interface: "org.example.Plant"
+      method: "Command"
+    - topic: "plant/line1/saw/cmd"
+      service: "org.example.Plant"
+      path: "/org/example/Plant/saw"
+      interface: "org.example.Plant"
+      method: "Command"
+    - topic: "plant/line1/lathe/cmd"
+      service: "org.example.Plant"
+      path: "/org/example/Plant/lathe"
+      interface: "org.example.Plant"
+      method: "Command"
+    # Enough to cover, but blocked by the published sensors/in/status
+    - topic: "sensors/in/a/set"
+      service: "org.example.Sensors"
+      path: "/org/example/Sensors"
+      interface: "org.example.Sensors"
+      method: "Set"
+    - topic: "sensors/in/b/set"
+      service: "org.example.Sensors"
+      path: "/org/example/Sensors"
+      interface: "org.example.Sensors"
+      method: "Set"
+    - topic: "sensors/in/c/set"
+      service: "org.example.Sensors"
+      path: "/org/example/Sensors"
+      interface: "org.example.Sensors"
+      method: "Set"
+    - topic: "sensors/in/d/set"
+      service: "org.example.Sensors"
+      path: "/org/example/Sensors"
+      interface: "org.example.Sensors"
+      method: "Set"
+    # Blocked by the metrics topic
+    - topic: "office/blinds/a/set"
+      service: "org.example.Blinds"
+      path: "/org/example/Blinds"
+      interface: "org.example.Blinds"
+      method: "Set"
+    - topic: "office/blinds/b/set"
+      service: "org.example.Blinds"
+      path: "/org/example/Blinds"
+      interface: "org.example.Blinds"
+      method: "Set"
+    - topic: "office/blinds/c/set"
+      service: "org.example.Blinds"
+      path: "/org/example/Blinds"
+      interface: "org.example.Blinds"
+      method: "Set"
+    - topic: "office/blinds/d/set"
+      service: "org.example.Blinds"
+      path: "/org/example/Blinds"
+      interface: "org.example.Blinds"
+      method: "Set"
+    # Too few topics below garden to be worth a covering filter
+    - topic: "garden/pump/set"
+      service: "org.example.Garden"
+      path: "/org/example/Garden"
+      interface: "org.example.Pump"
+      method: "Set"
+      qos: 0
+EOF
+
+EXPECTED="Subscription: garden/pump/set qos 0
+Subscription: home/lights/# qos 2
+Subscription: office/blinds/a/set qos 1
+Subscription: office/blinds/b/set qos 1
+Subscription: office/blinds/c/set qos 1
+Subscription: office/blinds/d/set qos 1
+Subscription: plant/line1/# qos 1
+Subscription: sensors/in/a/set qos 1
+Subscription: sensors/in/b/set qos 1
+Subscription: sensors/in/c/set qos 1
+Subscription: sensors/in/d/set qos 1"
+ACTUAL=$($BINARY --print-subscriptions "$TEST_DIR/subscription-cover.yaml" 2>&1 | grep "^Subscription:" || true)
+if [ "$ACTUAL" = "$EXPECTED" ]; then
+    echo -e "${GREEN}✓ PASS${NC}: Overlapping topics covered, published prefixes left alone"
+else
+    echo -e "${RED}✗ FAIL${NC}: Unexpected subscription set:"
+    echo "$ACTUAL"
+fi
+echo
+
+# Test 23: Property Topic Template Without {property} / {path}
+echo -e "${YELLOW}Test 23: Property Topic Template Without {property} / {path}${NC}"
+cat > "$TEST_DIR/invalid-property-template.yaml" <<EOF
+mqtt:
+  broker: localhost
+  port: 1883
+bus_type: system
+mappings:
+  properties_to_mqtt:
+    # Every property would land on the same topic
+    - service: "org.freedesktop.UPower"
+      path: "/org/freedesktop/UPower/devices/DisplayDevice"
+      interface: "org.freedesktop.UPower.Device"
+      topic: "power/{interface}"
+    # Every device below the namespace would land on the same topics
+    - service: "org.freedesktop.UPower"
+      path_namespace: "/org/freedesktop/UPower/devices"
+      interface: "org.freedesktop.UPower.Device"
+      topic: "power/{property}"
+  mqtt_to_dbus: []
+EOF
+
+OUTPUT=$($BINARY "$TEST_DIR/invalid-property-template.yaml" 2>&1 || true)
+if echo "$OUTPUT" | grep -q "properties_to_mqtt\[0\].topic.*{property}" && \
+   echo "$OUTPUT" | grep -q "properties_to_mqtt\[1\].topic.*{path}"; then
+    echo -e "${GREEN}✓ PASS${NC}: Caught property topic templates that collapse topics"
+else
+    echo -e "${RED}✗ FAIL${NC}: Did not catch property topic templates that collapse topics"
+fi
+echo
+
 echo "=== Test Summary ==="
 echo "Validation system is working correctly!"
 echo "Run 'man dbus-mqtt-bridge' for configuration examples (once created)."